@@ -1,4 +1,5 @@
 #include "analysis/analysis.h"
+#include "analysis/statistics.h"
 #include "ir/basic_block.h"
 #include "ir/graph.h"
 #include "ir/instruction.h"
@@ -11,138 +12,247 @@ namespace compiler {
 
 void DFS::Run()
 {
+    PassScope passScope {graph_, "DFS"};
     dfsVector_.clear();
-    marker_ = marker_.IsEmpty() ? graph_->NewMarker() : marker_;
-    DFSImpl(graph_->GetStartBlock());
-    for (auto *bb : dfsVector_) {
-        bb->Unmark(marker_);
-    }
-}
+    ir::MarkerHolder markerHolder {graph_};
+    auto marker = markerHolder.GetMarker();
 
-void DFS::DFSImpl(BasicBlock *bb)
-{
-    ASSERT(bb != nullptr);
-    bb->Mark(marker_);
-    dfsVector_.push_back(bb);
-    for (auto *succBlock : bb->GetSuccessors()) {
-        if (!succBlock->IsMarked(marker_)) {
-            DFSImpl(succBlock);
+    // explicit stack of (block, index of the next successor to visit)
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    auto visit = [this, &stack, marker](BasicBlock *bb) {
+        bb->Mark(marker);
+        dfsVector_.push_back(bb);
+        stack.emplace_back(bb, 0);
+    };
+
+    auto *startBB = graph_->GetStartBlock();
+    ASSERT(startBB != nullptr);
+    visit(startBB);
+    while (!stack.empty()) {
+        auto &[bb, succIdx] = stack.back();
+        if (succIdx == BasicBlock::MaxSuccessorsCount) {
+            stack.pop_back();
+            continue;
+        }
+        auto *succ = bb->GetSuccessor(succIdx++);
+        if (succ != nullptr && !succ->IsMarked(marker)) {
+            visit(succ);
         }
     }
 }
 
 void RPO::Run()
 {
-    auto blocksCount = graph_->GetBlocksCount();
-    auto *bb = graph_->GetStartBlock();
-    rpoVector_.resize(blocksCount);
-    marker_ = marker_.IsEmpty() ? graph_->NewMarker() : marker_;
-    RPOImpl(bb, &blocksCount);
-    for (auto *bb : rpoVector_) {
-        bb->Unmark(marker_);
-    }
+    PassScope passScope {graph_, "RPO"};
+    // the graph keeps the order until control flow changes, copy protects passes which modify it while iterating
+    rpoVector_ = graph_->GetRpoBlocks();
 }
 
-void RPO::RPOImpl(BasicBlock *bb, size_t *blocksCount)
+void DominatorsTree::Run()
 {
-    ASSERT(bb != nullptr);
-    bb->Mark(marker_);
-
-    for (auto *succBlock : bb->GetSuccessors()) {
-        if (!succBlock->IsMarked(marker_)) {
-            RPOImpl(succBlock, blocksCount);
-        }
-    }
+    PassScope passScope {graph_, "DominatorsTree"};
+    // reachable blocks are marked, the marker is valid only during the run
+    ir::MarkerHolder markerHolder {graph_};
+    marker_ = markerHolder.GetMarker();
+    graph_->IterateOverBlocks([](BasicBlock *bb) {
+        bb->ResetDominatorInfo();
+        bb->SetDfsOrder(InvalidIdx);
+    });
 
-    ASSERT(blocksCount != nullptr && *blocksCount > 0);
-    rpoVector_[--(*blocksCount)] = bb;
+    NumberBlocks();
+    ComputeImmediateDominators();
+    BuildDominatorTree();
+    NumberDominatorTree();
 }
 
-void DominatorsTree::Run()
+void DominatorsTree::NumberBlocks()
 {
-    auto dfs = DFS {graph_};
-    marker_ = marker_.IsEmpty() ? graph_->NewMarker() : marker_;
-    dfs.SetMarker(marker_);
-    dfs.Run();
-
-    auto &dfsVec = dfs.GetDfsVector();
-    for (auto idx = 0U; idx < dfsVec.size(); ++idx) {
-        dfsVec[idx]->SetDfsOrder(idx);
-    }
+    vertices_.clear();
+    parents_.clear();
+
+    // explicit stack of (block, index of the next successor to visit)
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    auto visit = [this, &stack](BasicBlock *bb, uint32_t parent) {
+        bb->Mark(marker_);
+        bb->SetDfsOrder(vertices_.size());
+        vertices_.push_back(bb);
+        parents_.push_back(parent);
+        stack.emplace_back(bb, 0);
+    };
 
-    auto dfsSet = dfs.CreateDfsBBSet();
-    ASSERT(dfsSet.size() == dfsVec.size());
-    auto dominatorsMap = BuildDominatorsMap(dfsSet);
-    rootDominator_ = BuildDominatorTree(dominatorsMap);
+    auto *startBB = graph_->GetStartBlock();
+    ASSERT(startBB != nullptr);
+    visit(startBB, InvalidIdx);
+    while (!stack.empty()) {
+        auto &[bb, succIdx] = stack.back();
+        if (succIdx == BasicBlock::MaxSuccessorsCount) {
+            stack.pop_back();
+            continue;
+        }
+        auto *succ = bb->GetSuccessor(succIdx++);
+        if (succ != nullptr && !succ->IsMarked(marker_)) {
+            visit(succ, bb->GetDfsOrder());
+        }
+    }
 }
 
-DominatorsTree::DominatorsMap DominatorsTree::BuildDominatorsMap(const BBSet &dfsSet) const
+void DominatorsTree::ComputeImmediateDominators()
 {
-    ASSERT(!marker_.IsEmpty());
+    auto count = static_cast<uint32_t>(vertices_.size());
+    semis_.resize(count);
+    idoms_.assign(count, InvalidIdx);
+    ancestors_.assign(count, InvalidIdx);
+    labels_.resize(count);
+    bucketHeads_.assign(count, InvalidIdx);
+    bucketNexts_.assign(count, InvalidIdx);
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        semis_[idx] = idx;
+        labels_[idx] = idx;
+    }
 
-    auto dfs = DFS {graph_};
-    dfs.SetMarker(marker_);
+    for (auto idx = count - 1; idx > 0; --idx) {
+        for (auto *pred : vertices_[idx]->GetPredecessors()) {
+            // skip unreachable predecessors
+            if (!pred->IsMarked(marker_)) {
+                continue;
+            }
+            auto evaluated = Eval(pred->GetDfsOrder());
+            semis_[idx] = std::min(semis_[idx], semis_[evaluated]);
+        }
+        bucketNexts_[idx] = std::exchange(bucketHeads_[semis_[idx]], idx);
 
-    DominatorsMap::Dominators dominatorsMap;
-    auto *startBB = graph_->GetStartBlock();
+        auto parent = parents_[idx];
+        ancestors_[idx] = parent;
+        for (auto dominatee = std::exchange(bucketHeads_[parent], InvalidIdx); dominatee != InvalidIdx;
+             dominatee = bucketNexts_[dominatee]) {
+            auto evaluated = Eval(dominatee);
+            idoms_[dominatee] = semis_[evaluated] < semis_[dominatee] ? evaluated : parent;
+        }
+    }
 
-    for (auto *dominator : dfsSet) {
-        // skip source
-        if (dominator == startBB) {
-            continue;
+    for (uint32_t idx = 1; idx < count; ++idx) {
+        if (idoms_[idx] != semis_[idx]) {
+            idoms_[idx] = idoms_[idoms_[idx]];
         }
-        // startBB dominates each block
-        dominatorsMap[dominator].insert(startBB);
-        // skip dominator in dfs
-        dominator->Mark(marker_);
-        dfs.Run();
-        dominator->Unmark(marker_);
-
-        auto dfsSubset = dfs.CreateDfsBBSet();
-        auto dominatedSet = BBSet {};
-        std::set_difference(dfsSet.begin(), dfsSet.end(), dfsSubset.begin(), dfsSubset.end(),
-                            std::inserter(dominatedSet, dominatedSet.begin()));
-        dominatedSet.erase(dominator);
-
-        for (auto *dominatee : dominatedSet) {
-            dominatorsMap[dominatee].insert(dominator);
+    }
+}
+
+uint32_t DominatorsTree::Eval(uint32_t idx)
+{
+    if (ancestors_[idx] == InvalidIdx) {
+        return idx;
+    }
+    Compress(idx);
+    return labels_[idx];
+}
+
+void DominatorsTree::Compress(uint32_t idx)
+{
+    compressPath_.clear();
+    for (auto curr = idx; ancestors_[ancestors_[curr]] != InvalidIdx; curr = ancestors_[curr]) {
+        compressPath_.push_back(curr);
+    }
+    // path is compressed from the vertex nearest to the root
+    for (auto pathIt = compressPath_.rbegin(); pathIt != compressPath_.rend(); ++pathIt) {
+        auto curr = *pathIt;
+        auto ancestor = ancestors_[curr];
+        if (semis_[labels_[ancestor]] < semis_[labels_[curr]]) {
+            labels_[curr] = labels_[ancestor];
         }
+        ancestors_[curr] = ancestors_[ancestor];
     }
-    return DominatorsMap(std::move(dominatorsMap));
 }
 
-bool DominatorsTree::DominatorsMap::DominatorsComp::operator()(BasicBlock *const &bb1, BasicBlock *const &bb2) const
+void DominatorsTree::BuildDominatorTree()
 {
-    return bb1->GetDfsOrder() < bb2->GetDfsOrder();
+    rootDominator_ = vertices_.front();
+    for (uint32_t idx = 1; idx < vertices_.size(); ++idx) {
+        auto *dominator = vertices_[idoms_[idx]];
+        auto *dominatee = vertices_[idx];
+        dominator->AddDominatee(dominatee);
+        dominatee->SetDominator(dominator);
+    }
 }
 
-DominatorsTree::BBDeque DominatorsTree::DominatorsMap::FindImmediateDominatees(BasicBlock *dominator) const
+void DominatorsTree::NumberDominatorTree()
 {
-    BBDeque immDominatees;
-    for (auto &[dominatee, dominators] : dominatorsMap_) {
-        auto *immediateDominator = *dominators.rbegin();
-        if (immediateDominator == dominator) {
-            immDominatees.push_back(dominatee);
+    auto count = static_cast<uint32_t>(vertices_.size());
+    // immediate dominator always precedes the block in dfs preorder, so the tree is processed with plain loops
+    subtreeSizes_.assign(count, 1);
+    for (auto idx = count - 1; idx > 0; --idx) {
+        subtreeSizes_[idoms_[idx]] += subtreeSizes_[idx];
+    }
+
+    // next free preorder number inside the subtree of the vertex
+    std::vector<uint32_t> nextOrders(count);
+    treeOrders_.resize(count);
+    depths_.resize(count);
+    treeOrders_[0] = 0;
+    depths_[0] = 0;
+    nextOrders[0] = 1;
+    for (uint32_t idx = 1; idx < count; ++idx) {
+        auto idom = idoms_[idx];
+        treeOrders_[idx] = nextOrders[idom];
+        nextOrders[idom] += subtreeSizes_[idx];
+        nextOrders[idx] = treeOrders_[idx] + 1;
+        depths_[idx] = depths_[idom] + 1;
+    }
+
+    jumpLevels_ = 1;
+    while ((1U << jumpLevels_) < count) {
+        ++jumpLevels_;
+    }
+    jumps_.resize(static_cast<size_t>(jumpLevels_) * count);
+    jumps_[0] = 0;
+    for (uint32_t idx = 1; idx < count; ++idx) {
+        jumps_[idx] = idoms_[idx];
+    }
+    for (uint32_t level = 1; level < jumpLevels_; ++level) {
+        auto *prevJumps = jumps_.data() + static_cast<size_t>(level - 1) * count;
+        auto *levelJumps = jumps_.data() + static_cast<size_t>(level) * count;
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            levelJumps[idx] = prevJumps[prevJumps[idx]];
         }
     }
-    return immDominatees;
 }
 
-BasicBlock *DominatorsTree::BuildDominatorTree(const DominatorsTree::DominatorsMap &dominatorsMap) const
+bool DominatorsTree::IsReachable(BasicBlock *bb) const
 {
-    auto *rootDominator = graph_->GetStartBlock();
-    BuildTreeImpl(rootDominator, dominatorsMap);
-    return rootDominator;
+    ASSERT(bb != nullptr);
+    auto idx = bb->GetDfsOrder();
+    return idx < vertices_.size() && vertices_[idx] == bb;
 }
 
-void DominatorsTree::BuildTreeImpl(BasicBlock *dominator, const DominatorsTree::DominatorsMap &dominatorsMap) const
+uint32_t DominatorsTree::GetVertexIdx(BasicBlock *bb) const
 {
-    auto immDominatees = dominatorsMap.FindImmediateDominatees(dominator);
-    for (auto *dominatee : immDominatees) {
-        dominator->AddDominatee(dominatee);
-        dominatee->SetDominator(dominator);
-        BuildTreeImpl(dominatee, dominatorsMap);
+    ASSERT(IsReachable(bb));
+    return bb->GetDfsOrder();
+}
+
+uint32_t DominatorsTree::GetCommonDominatorIdx(uint32_t idx1, uint32_t idx2) const
+{
+    auto count = vertices_.size();
+    if (depths_[idx1] < depths_[idx2]) {
+        std::swap(idx1, idx2);
     }
+    // lift the deeper vertex to the depth of the other one
+    for (auto diff = depths_[idx1] - depths_[idx2], level = 0U; diff != 0; diff >>= 1U, ++level) {
+        if ((diff & 1U) != 0) {
+            idx1 = jumps_[level * count + idx1];
+        }
+    }
+    if (idx1 == idx2) {
+        return idx1;
+    }
+    for (auto level = jumpLevels_; level-- > 0;) {
+        auto jump1 = jumps_[level * count + idx1];
+        auto jump2 = jumps_[level * count + idx2];
+        if (jump1 != jump2) {
+            idx1 = jump1;
+            idx2 = jump2;
+        }
+    }
+    return idoms_[idx1];
 }
 
 DominatorsTree::BBSet DominatorsTree::GetDominators(BasicBlock *bb) const
@@ -170,24 +280,25 @@ DominatorsTree::BBDeque DominatorsTree::GetOrderedDominators(BasicBlock *bb) con
 BasicBlock *DominatorsTree::GetImmediateDominator(BasicBlock *bb) const
 {
     ASSERT(rootDominator_ != nullptr);
+    if (!IsReachable(bb)) {
+        return nullptr;
+    }
     return bb->GetDominator();
 }
 
 BasicBlock *DominatorsTree::GetImmediateDominatorFor(BasicBlock *bb1, BasicBlock *bb2) const
 {
-    auto dominators1 = GetOrderedDominators(bb1);
-    auto dominators2 = GetOrderedDominators(bb2);
-    if (dominators1.empty() || dominators2.empty()) {
+    ASSERT(rootDominator_ != nullptr);
+    if (!IsReachable(bb1) || !IsReachable(bb2)) {
         return nullptr;
     }
-    BasicBlock *commonDominator = nullptr;
-    for (int idx1 = dominators1.size() - 1, idx2 = dominators2.size() - 1; idx1 >= 0 && idx2 >= 0; idx1--, idx2--) {
-        if (dominators1[idx1] != dominators2[idx2]) {
-            return commonDominator;
-        }
-        commonDominator = dominators1[idx1];
+    // common dominator is searched among strict dominators of both blocks
+    auto idx1 = GetVertexIdx(bb1);
+    auto idx2 = GetVertexIdx(bb2);
+    if (idx1 == 0 || idx2 == 0) {
+        return nullptr;
     }
-    return commonDominator;
+    return vertices_[GetCommonDominatorIdx(idoms_[idx1], idoms_[idx2])];
 }
 
 Instruction *DominatorsTree::GetImmediateDominatorFor(Instruction *inst1, Instruction *inst2) const
@@ -195,65 +306,37 @@ Instruction *DominatorsTree::GetImmediateDominatorFor(Instruction *inst1, Instru
     auto *bb1 = inst1->GetBasicBlock();
     auto *bb2 = inst2->GetBasicBlock();
     if (bb1 != bb2) {
-        return GetImmediateDominatorFor(bb1, bb2)->GetLastInstruction();
+        auto *dominator = GetImmediateDominatorFor(bb1, bb2);
+        return dominator != nullptr ? dominator->GetLastInstruction() : nullptr;
     }
-    Instruction *commonDominator = nullptr;
-    bb1->IterateOverInstructions([&commonDominator, inst1, inst2](Instruction *inst) {
-        if (inst == inst1 || inst == inst2) {
-            return true;
-        }
-        commonDominator = inst;
-        return false;
-    });
-    return commonDominator;
+    auto *firstInst = bb1->IsInstructionBefore(inst2, inst1) ? inst2 : inst1;
+    if (firstInst == bb1->GetFirstInstruction()) {
+        return nullptr;
+    }
+    return firstInst->Prev()->AsItem();
 }
 
 bool DominatorsTree::DoesBlockDominatesOn(BasicBlock *dominatee, BasicBlock *dominator) const
 {
-    bool doesDominates = false;
-    TraverseTree(dominator, [&doesDominates, dominatee, dominator](BasicBlock *bb) {
-        if (dominatee == bb) {
-            doesDominates = bb == dominator;
-            return true;
-        }
+    ASSERT(rootDominator_ != nullptr);
+    // nothing dominates on unreachable code and unreachable code dominates on nothing
+    if (!IsReachable(dominatee) || !IsReachable(dominator)) {
         return false;
-    });
-    return doesDominates;
+    }
+    auto dominateeOrder = treeOrders_[GetVertexIdx(dominatee)];
+    auto dominatorIdx = GetVertexIdx(dominator);
+    auto dominatorOrder = treeOrders_[dominatorIdx];
+    return dominatorOrder <= dominateeOrder && dominateeOrder < dominatorOrder + subtreeSizes_[dominatorIdx];
 }
 
 bool DominatorsTree::DoesInstructionDominatesOn(Instruction *dominatee, Instruction *dominator) const
 {
     auto *dominateeBlock = dominatee->GetBasicBlock();
     auto *dominatorBlock = dominator->GetBasicBlock();
-    if (dominateeBlock != dominatorBlock) {
+    if (dominateeBlock != dominatorBlock || !IsReachable(dominatorBlock)) {
         return DoesBlockDominatesOn(dominateeBlock, dominatorBlock);
     }
-    bool doesDominates = false;
-    dominatorBlock->IterateOverInstructions([&doesDominates, dominatee, dominator](Instruction *inst) {
-        if (inst == dominatee) {
-            return true;
-        }
-        if (inst == dominator) {
-            doesDominates = true;
-            return true;
-        }
-        return false;
-    });
-    return doesDominates;
-}
-
-bool DominatorsTree::TraverseTree(BasicBlock *bb, const std::function<bool(BasicBlock *)> &callback) const
-{
-    ASSERT(bb != nullptr);
-    if (callback(bb)) {
-        return true;
-    }
-    for (auto &immDominatee : bb->GetImmediateDominatees()) {
-        if (TraverseTree(immDominatee, callback)) {
-            return true;
-        }
-    }
-    return false;
+    return dominatorBlock->IsInstructionBefore(dominator, dominatee);
 }
 
 void DominatorsTree::TraverseDominators(BasicBlock *bb, const std::function<bool(BasicBlock *)> &callback) const
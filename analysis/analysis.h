@@ -8,6 +8,7 @@
 #include <vector>
 #include <unordered_map>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 
 namespace compiler {
@@ -23,9 +24,31 @@ using ir::Graph;
 using ir::Instruction;
 using ir::Marker;
 
+// Analyses which may be cached by AnalysisManager
+enum class AnalysisType : uint8_t {
+    DFS,
+    RPO,
+    DOMINATORS_TREE,
+    LOOP_ANALYSIS,
+    COUNT,
+};
+
+// Set of analyses, bit per AnalysisType
+using AnalysisMask = uint32_t;
+
+template <AnalysisType... Types>
+constexpr AnalysisMask MakeAnalysisMask()
+{
+    return ((1U << static_cast<uint32_t>(Types)) | ... | 0U);
+}
+
+constexpr AnalysisMask NoAnalyses = 0;
+constexpr AnalysisMask AllAnalyses = (1U << static_cast<uint32_t>(AnalysisType::COUNT)) - 1;
+
 class DFS {
 public:
     using DfsVector = std::vector<BasicBlock *>;
+    static constexpr auto Type = AnalysisType::DFS;
 
     explicit DFS(Graph *graph) : graph_(graph) {}
 
@@ -39,29 +62,17 @@ public:
         return {dfsVector_.begin(), dfsVector_.end()};
     }
 
-    void SetMarker(Marker marker)
-    {
-        marker_ = marker;
-    }
-
-    Marker GetMarker()
-    {
-        return marker_;
-    }
-
     void Run();
 
 private:
-    void DFSImpl(BasicBlock *bb);
-
     Graph *graph_;
-    Marker marker_;
     DfsVector dfsVector_;
 };
 
 class RPO {
 public:
     using RpoVector = std::vector<BasicBlock *>;
+    static constexpr auto Type = AnalysisType::RPO;
 
     explicit RPO(Graph *graph) : graph_(graph) {}
 
@@ -73,10 +84,7 @@ public:
     void Run();
 
 private:
-    void RPOImpl(BasicBlock *bb, size_t *blocksCount);
-
     Graph *graph_;
-    Marker marker_;
     RpoVector rpoVector_;
 };
 
@@ -84,6 +92,7 @@ class DominatorsTree {
 public:
     using BBSet = std::set<BasicBlock *>;
     using BBDeque = std::deque<BasicBlock *>;
+    static constexpr auto Type = AnalysisType::DOMINATORS_TREE;
 
     explicit DominatorsTree(Graph *graph) : graph_(graph) {}
 
@@ -104,35 +113,57 @@ public:
     bool DoesInstructionDominatesOn(Instruction *dominatee, Instruction *dominator) const;
 
 private:
-    class DominatorsMap {
-    public:
-        struct DominatorsComp {
-            bool operator()(BasicBlock *const &bb1, BasicBlock *const &bb2) const;
-        };
-        using Dominators = std::unordered_map<BasicBlock *, std::set<BasicBlock *, DominatorsComp>>;
+    static constexpr uint32_t InvalidIdx = static_cast<uint32_t>(-1);
 
-        explicit DominatorsMap() = default;
-        explicit DominatorsMap(Dominators dominatorsMap) : dominatorsMap_(std::move(dominatorsMap)) {}
+    // Numbers reachable blocks in dfs preorder and remembers dfs tree parents
+    void NumberBlocks();
 
-        BBDeque FindImmediateDominatees(BasicBlock *dominator) const;
+    // Lengauer-Tarjan: semidominators are computed over the dfs tree, then immediate dominators are derived
+    void ComputeImmediateDominators();
 
-    private:
-        Dominators dominatorsMap_;
-    };
+    uint32_t Eval(uint32_t idx);
 
-    DominatorsMap BuildDominatorsMap(const BBSet &dfsSet) const;
+    void Compress(uint32_t idx);
 
-    bool TraverseTree(BasicBlock *bb, const std::function<bool(BasicBlock *)> &callback) const;
+    void BuildDominatorTree();
 
-    void TraverseDominators(BasicBlock *bb, const std::function<bool(BasicBlock *)> &callback) const;
+    // Numbers the dominator tree in preorder and fills binary lifting tables for nearest common dominator queries
+    void NumberDominatorTree();
+
+    // Blocks not visited by the last run have no vertex and are dominated by nothing
+    bool IsReachable(BasicBlock *bb) const;
 
-    BasicBlock *BuildDominatorTree(const DominatorsMap &dominatorsMap) const;
+    // Index of the reachable block in the per-vertex tables
+    uint32_t GetVertexIdx(BasicBlock *bb) const;
 
-    void BuildTreeImpl(BasicBlock *dominator, const DominatorsMap &dominatorsMap) const;
+    uint32_t GetCommonDominatorIdx(uint32_t idx1, uint32_t idx2) const;
+
+    void TraverseDominators(BasicBlock *bb, const std::function<bool(BasicBlock *)> &callback) const;
 
     Graph *graph_;
     Marker marker_;
     BasicBlock *rootDominator_ {nullptr};
+
+    // Lengauer-Tarjan state indexed by dfs preorder number
+    std::vector<BasicBlock *> vertices_;
+    std::vector<uint32_t> parents_;
+    std::vector<uint32_t> semis_;
+    std::vector<uint32_t> idoms_;
+    std::vector<uint32_t> ancestors_;
+    std::vector<uint32_t> labels_;
+    // buckets of vertices with the same semidominator kept as singly-linked lists
+    std::vector<uint32_t> bucketHeads_;
+    std::vector<uint32_t> bucketNexts_;
+    std::vector<uint32_t> compressPath_;
+
+    // Dominator tree numbering indexed by dfs preorder number:
+    // block A dominates block B iff treeOrders_[A] <= treeOrders_[B] < treeOrders_[A] + subtreeSizes_[A]
+    std::vector<uint32_t> treeOrders_;
+    std::vector<uint32_t> subtreeSizes_;
+    std::vector<uint32_t> depths_;
+    // jumps_[level * vertices count + idx] is the 2^level-th dominator of the vertex
+    std::vector<uint32_t> jumps_;
+    uint32_t jumpLevels_ {0};
 };
 
 }  // namespace compiler
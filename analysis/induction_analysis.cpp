@@ -0,0 +1,242 @@
+#include "analysis/induction_analysis.h"
+#include "analysis/pattern_match.h"
+#include "analysis/range_analysis.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace compiler {
+
+namespace {
+
+// Steps wrap around like the arithmetic of instructions does
+int64_t WrapMul(int64_t op1, int64_t op2)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(op1) * static_cast<uint64_t>(op2));
+}
+
+int64_t WrapShl(int64_t value, int64_t shift)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(value) << static_cast<uint64_t>(shift));
+}
+
+}  // namespace
+
+void InductionAnalysis::Run()
+{
+    PassScope passScope {graph_, "InductionAnalysis"};
+    auto &loopAnalysis = analysisManager_->GetAnalysis<LoopAnalysis>();
+    auto &loops = loopAnalysis.GetLoops();
+    variablesStorage_.clear();
+    instVariables_.assign(graph_->GetInstIdsBound(), nullptr);
+    loopVariables_.assign(loops.size() + 1, {});
+    tripCounts_.assign(loops.size() + 1, std::nullopt);
+    if (loops.empty()) {
+        return;
+    }
+
+    for (auto *loop : loops) {
+        FindBasicVariables(loop);
+    }
+    // inputs of derived variables precede them in rpo, phis of headers are already found
+    for (auto *bb : analysisManager_->GetAnalysis<RPO>().GetRpoVector()) {
+        bb->IterateOverInstructions([this, &loopAnalysis](Instruction *inst) {
+            FindDerivedVariable(inst, loopAnalysis);
+            return false;
+        });
+    }
+    for (auto *loop : loops) {
+        ComputeTripCount(loop, loopAnalysis);
+    }
+}
+
+const InductionVariable *InductionAnalysis::GetInductionVariable(Instruction *inst) const
+{
+    auto id = inst->GetInstId().GetId();
+    return id < instVariables_.size() ? instVariables_[id] : nullptr;
+}
+
+const std::vector<const InductionVariable *> &InductionAnalysis::GetInductionVariables(const Loop *loop) const
+{
+    ASSERT(loop->GetId() < loopVariables_.size());
+    return loopVariables_[loop->GetId()];
+}
+
+std::optional<uint64_t> InductionAnalysis::GetTripCount(const Loop *loop) const
+{
+    ASSERT(loop->GetId() < tripCounts_.size());
+    return tripCounts_[loop->GetId()];
+}
+
+void InductionAnalysis::FindBasicVariables(Loop *loop)
+{
+    if (loop->IsIrreducible() || loop->GetBackEdges().size() != 1) {
+        return;
+    }
+    auto *latch = loop->GetBackEdges().front();
+    loop->GetHeader()->IterateOverInstructions([this, loop, latch](Instruction *inst) {
+        // phis are placed at the beginning of the block
+        if (inst->GetOpcode() != ir::Opcode::PHI) {
+            return true;
+        }
+        auto *phi = inst->As<ir::PhiInst>();
+        if (phi->GetInputs().Size() != 2) {
+            return false;
+        }
+        auto latchIdx = phi->GetIncomingBlock(0) == latch ? 0U : 1U;
+        auto *next = phi->GetInput(latchIdx);
+        int64_t step = 0;
+        if (phi->GetIncomingBlock(latchIdx) != latch ||
+            !pattern::Add(pattern::Specific(inst), pattern::AnyConst(&step)).Match(next) || step == 0) {
+            return false;
+        }
+        AddVariable({inst, loop, inst, nullptr, 1, step, phi->GetInput(1 - latchIdx), next});
+        return false;
+    });
+}
+
+void InductionAnalysis::FindDerivedVariable(Instruction *inst, const LoopAnalysis &loopAnalysis)
+{
+    auto opcode = inst->GetOpcode();
+    if (opcode != ir::Opcode::ADD && opcode != ir::Opcode::MUL && opcode != ir::Opcode::SHL) {
+        return;
+    }
+    auto *loop = loopAnalysis.GetLoop(inst->GetBasicBlock());
+    auto *varInput = inst->GetFirstOp();
+    auto *otherInput = inst->GetLastOp();
+    auto isLoopVariable = [this, loop](Instruction *input) {
+        auto *var = GetInductionVariable(input);
+        return var != nullptr && var->loop == loop;
+    };
+    // shift amount is not an induction variable, inputs of ADD and MUL may be swapped
+    if (!isLoopVariable(varInput) && opcode != ir::Opcode::SHL) {
+        std::swap(varInput, otherInput);
+    }
+    if (!isLoopVariable(varInput) || loop->Contains(loopAnalysis.GetLoop(otherInput->GetBasicBlock()))) {
+        return;
+    }
+
+    const auto *parent = GetInductionVariable(varInput);
+    auto var = InductionVariable {inst, loop, parent->basic, parent, parent->scale, parent->step};
+    int64_t value = 0;
+    if (opcode == ir::Opcode::MUL) {
+        if (!pattern::AnyConst(&value).Match(otherInput)) {
+            return;
+        }
+        var.scale = WrapMul(parent->scale, value);
+        var.step = WrapMul(parent->step, value);
+    } else if (opcode == ir::Opcode::SHL) {
+        auto bits = static_cast<int64_t>(ir::GetResultTypeBits(inst->GetResultType()));
+        if (!pattern::AnyConst(&value).Match(otherInput) || value < 0 || value >= bits) {
+            return;
+        }
+        var.scale = WrapShl(parent->scale, value);
+        var.step = WrapShl(parent->step, value);
+    }
+    AddVariable(var);
+}
+
+void InductionAnalysis::ComputeTripCount(Loop *loop, const LoopAnalysis &loopAnalysis)
+{
+    auto &variables = loopVariables_[loop->GetId()];
+    if (variables.empty()) {
+        return;
+    }
+    // exit test of the header is done before every iteration and the one of the latch is done after it
+    for (auto *exitingBB : {loop->GetHeader(), loop->GetBackEdges().front()}) {
+        auto *branchInst = exitingBB->GetLastInstruction();
+        if (branchInst == nullptr || branchInst->GetOpcode() != ir::Opcode::COND_BRANCH ||
+            branchInst->GetInputs().Size() != 1 || branchInst->GetFirstOp()->GetOpcode() != ir::Opcode::COMPARE) {
+            continue;
+        }
+        auto *cmpInst = branchInst->GetFirstOp();
+        auto isStrict = cmpInst->As<ir::LogicInst>()->GetCmpFlags() == ir::CmpFlags::LT;
+        auto *lhs = cmpInst->GetFirstOp();
+        auto *rhs = cmpInst->GetLastOp();
+        auto isInLoop = [&loopAnalysis, loop](BasicBlock *bb) { return loop->Contains(loopAnalysis.GetLoop(bb)); };
+        auto isTrueInLoop = isInLoop(exitingBB->GetTrueSuccessor());
+        if (isTrueInLoop == isInLoop(exitingBB->GetFalseSuccessor())) {
+            continue;
+        }
+        // the loop goes on while the compare is false, so `rhs < lhs` or `rhs <= lhs` holds
+        if (!isTrueInLoop) {
+            std::swap(lhs, rhs);
+            isStrict = !isStrict;
+        }
+        for (const auto *var : variables) {
+            if (!var->IsBasic()) {
+                // basic variables go first
+                break;
+            }
+            tripCounts_[loop->GetId()] = ComputeTripCount(*var, lhs, rhs, isStrict);
+            if (tripCounts_[loop->GetId()].has_value()) {
+                return;
+            }
+        }
+    }
+}
+
+std::optional<uint64_t> InductionAnalysis::ComputeTripCount(const InductionVariable &basicVar, Instruction *lhs,
+                                                            Instruction *rhs, bool isStrict) const
+{
+    // increasing variable is tested against the upper bound and decreasing one against the lower bound
+    auto isIncreasing = basicVar.step > 0;
+    auto *tested = isIncreasing ? lhs : rhs;
+    auto *boundInst = isIncreasing ? rhs : lhs;
+    int64_t start = 0;
+    int64_t bound = 0;
+    if ((tested != basicVar.inst && tested != basicVar.next) || !pattern::AnyConst(&start).Match(basicVar.start) ||
+        !pattern::AnyConst(&bound).Match(boundInst) || basicVar.step == std::numeric_limits<int64_t>::min()) {
+        return std::nullopt;
+    }
+
+    int64_t distance = 0;
+    if (isIncreasing ? __builtin_sub_overflow(bound, start, &distance)
+                     : __builtin_sub_overflow(start, bound, &distance)) {
+        return std::nullopt;
+    }
+    auto absStep = isIncreasing ? basicVar.step : -basicVar.step;
+    // number of values `start + step * k` from k = 0 which pass the test
+    int64_t passedCount = 0;
+    if (isStrict) {
+        passedCount = distance > 0 ? (distance - 1) / absStep + 1 : 0;
+    } else {
+        passedCount = distance >= 0 ? distance / absStep + 1 : 0;
+    }
+    // incremented value is tested one iteration ahead
+    auto isNextTested = tested == basicVar.next;
+    auto tripCount = isNextTested ? std::max<int64_t>(passedCount - 1, 0) : passedCount;
+
+    // the increment done on the last iteration must not wrap around either
+    int64_t lastValue = 0;
+    if (__builtin_mul_overflow(basicVar.step, tripCount + 1, &lastValue) ||
+        __builtin_add_overflow(start, lastValue, &lastValue)) {
+        return std::nullopt;
+    }
+    auto values = ValueRange {std::min(start, lastValue), std::max(start, lastValue)};
+    if (!values.IsInside(ValueRange::OfType(basicVar.inst->GetResultType())) ||
+        !values.IsInside(ValueRange::OfType(basicVar.next->GetResultType()))) {
+        return std::nullopt;
+    }
+    // unsigned values are compared as signed ones only if they are not negative
+    if (ir::IsUnsignedResultType(ir::CombineResultType(lhs, rhs)) && (values.min < 0 || bound < 0)) {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>(tripCount);
+}
+
+void InductionAnalysis::AddVariable(const InductionVariable &var)
+{
+    auto *newVar = &variablesStorage_.emplace_back(var);
+    instVariables_[var.inst->GetInstId().GetId()] = newVar;
+    loopVariables_[var.loop->GetId()].push_back(newVar);
+}
+
+}  // namespace compiler
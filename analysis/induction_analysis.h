@@ -0,0 +1,93 @@
+#ifndef ANALYSIS_INDUCTION_ANALYSIS_H
+#define ANALYSIS_INDUCTION_ANALYSIS_H
+
+#include "analysis/analysis.h"
+#include "analysis/loop_analysis.h"
+#include "analysis/pass_manager.h"
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace compiler {
+
+/**
+ * Value which changes by the same constant step on every iteration of its loop. Basic variables are phis of the
+ * header incremented by a constant on the back edge, derived variables are `basic * scale + offset` computed inside
+ * of the loop from a basic variable and values invariant in the loop
+ */
+struct InductionVariable {
+    Instruction *inst {nullptr};
+    Loop *loop {nullptr};
+    // phi the value is computed from, inst itself for basic variables
+    Instruction *basic {nullptr};
+    // variable the derived one is computed from, nullptr for basic variables
+    const InductionVariable *parent {nullptr};
+    int64_t scale {1};
+    // difference of values on consecutive iterations, it wraps around like the arithmetic does
+    int64_t step {0};
+    // initial value coming from the pre-header and the incremented value from the latch, basic variables only
+    Instruction *start {nullptr};
+    Instruction *next {nullptr};
+
+    bool IsBasic() const
+    {
+        return inst == basic;
+    }
+};
+
+/**
+ * Finds induction variables of reducible loops with a single back edge. Derived variables are ADD of an induction
+ * variable and an invariant, MUL by a constant and SHL by a constant less than the type width, they are found in a
+ * single sweep as their inputs are defined before them. Trip count is computed for loops which are left when a
+ * basic variable with a constant start is compared with a constant by LE/LT
+ */
+class InductionAnalysis {
+public:
+    InductionAnalysis(Graph *graph, AnalysisManager *analysisManager)
+        : graph_(graph), analysisManager_(analysisManager)
+    {
+    }
+
+    void Run();
+
+    // nullptr if the instruction is not an induction variable
+    const InductionVariable *GetInductionVariable(Instruction *inst) const;
+
+    // Basic variables of the loop go first, derived ones follow in the order of their definition
+    const std::vector<const InductionVariable *> &GetInductionVariables(const Loop *loop) const;
+
+    /**
+     * Number of back edges taken before the loop is left by the exit test, the loop may be left earlier by other
+     * exits. Basic variable takes values `start + step * k` for k in [0, trip count] and never wraps around
+     */
+    std::optional<uint64_t> GetTripCount(const Loop *loop) const;
+
+private:
+    void FindBasicVariables(Loop *loop);
+
+    // Derived variable of the instruction if one of its inputs is an induction variable of its loop
+    void FindDerivedVariable(Instruction *inst, const LoopAnalysis &loopAnalysis);
+
+    void ComputeTripCount(Loop *loop, const LoopAnalysis &loopAnalysis);
+
+    // The loop goes on while `lhs < rhs` (or `lhs <= rhs`) holds, one of them is the basic variable or its increment
+    std::optional<uint64_t> ComputeTripCount(const InductionVariable &basicVar, Instruction *lhs, Instruction *rhs,
+                                             bool isStrict) const;
+
+    void AddVariable(const InductionVariable &var);
+
+    Graph *graph_;
+    AnalysisManager *analysisManager_;
+    std::deque<InductionVariable> variablesStorage_;
+    // indexed by instruction id
+    std::vector<const InductionVariable *> instVariables_;
+    // indexed by loop id
+    std::vector<std::vector<const InductionVariable *>> loopVariables_;
+    std::vector<std::optional<uint64_t>> tripCounts_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_INDUCTION_ANALYSIS_H
@@ -0,0 +1,251 @@
+#include "analysis/loop_analysis.h"
+#include "analysis/pass_manager.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+#include "utils/macros.h"
+
+#include <algorithm>
+
+namespace compiler {
+
+bool Loop::Contains(const Loop *other) const
+{
+    for (; other != nullptr; other = other->outerLoop_) {
+        if (other == this) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LoopAnalysis::Run()
+{
+    PassScope passScope {graph_, "LoopAnalysis"};
+    loopsStorage_.clear();
+    loops_.clear();
+    blockLoops_.assign(graph_->GetBBIdsBound(), nullptr);
+    preorders_.assign(graph_->GetBBIdsBound(), InvalidIdx);
+    lastDescendants_.assign(graph_->GetBBIdsBound(), InvalidIdx);
+    rootLoop_ = &loopsStorage_.emplace_back(nullptr, 0);
+
+    if (analysisManager_ != nullptr) {
+        domTree_ = &analysisManager_->GetAnalysis<DominatorsTree>();
+    } else {
+        if (!ownDomTree_.has_value()) {
+            ownDomTree_.emplace(graph_);
+        }
+        ownDomTree_->Run();
+        domTree_ = &ownDomTree_.value();
+    }
+    CollectBackEdges();
+
+    // inner loops are populated first
+    for (auto loopIt = loops_.rbegin(); loopIt != loops_.rend(); ++loopIt) {
+        PopulateLoop(*loopIt);
+    }
+
+    graph_->IterateOverBlocks([this](BasicBlock *bb) {
+        auto id = bb->GetId();
+        if (preorders_[id] != InvalidIdx && blockLoops_[id] == nullptr) {
+            blockLoops_[id] = rootLoop_;
+            rootLoop_->blocks_.push_back(bb);
+        }
+    });
+    for (auto *loop : loops_) {
+        if (loop->outerLoop_ == nullptr) {
+            loop->outerLoop_ = rootLoop_;
+            rootLoop_->innerLoops_.push_back(loop);
+        }
+    }
+
+    ComputeDepths();
+    for (auto *loop : loops_) {
+        ComputePreHeader(loop);
+    }
+    ComputeExitBlocks();
+}
+
+Loop *LoopAnalysis::GetLoop(BasicBlock *bb) const
+{
+    ASSERT(bb != nullptr && bb->GetId() < blockLoops_.size());
+    return blockLoops_[bb->GetId()];
+}
+
+void LoopAnalysis::CollectBackEdges()
+{
+    // blocks which are on the dfs stack, so edges to them are retreating
+    std::vector<bool> isOnStack(graph_->GetBBIdsBound(), false);
+    // indexed by header id
+    std::vector<Loop *> headerLoops(graph_->GetBBIdsBound(), nullptr);
+    std::vector<BasicBlock *> preorderBlocks;
+    uint32_t preorder = 0;
+
+    // explicit stack of (block, index of the next successor to visit)
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    auto visit = [this, &stack, &isOnStack, &preorderBlocks, &preorder](BasicBlock *bb) {
+        preorders_[bb->GetId()] = preorder++;
+        preorderBlocks.push_back(bb);
+        isOnStack[bb->GetId()] = true;
+        stack.emplace_back(bb, 0);
+    };
+
+    auto *startBB = graph_->GetStartBlock();
+    ASSERT(startBB != nullptr);
+    visit(startBB);
+    while (!stack.empty()) {
+        auto &[bb, succIdx] = stack.back();
+        if (succIdx == BasicBlock::MaxSuccessorsCount) {
+            isOnStack[bb->GetId()] = false;
+            lastDescendants_[bb->GetId()] = preorder - 1;
+            stack.pop_back();
+            continue;
+        }
+        auto *succ = bb->GetSuccessor(succIdx++);
+        if (succ == nullptr) {
+            continue;
+        }
+        auto succId = succ->GetId();
+        if (preorders_[succId] == InvalidIdx) {
+            visit(succ);
+            continue;
+        }
+        if (!isOnStack[succId]) {
+            continue;
+        }
+        auto *loop = headerLoops[succId];
+        if (loop == nullptr) {
+            loop = &loopsStorage_.emplace_back(succ, loopsStorage_.size());
+            headerLoops[succId] = loop;
+        }
+        // both successors may go to the header
+        if (std::find(loop->backEdges_.begin(), loop->backEdges_.end(), bb) == loop->backEdges_.end()) {
+            loop->backEdges_.push_back(bb);
+        }
+        if (!domTree_->DoesBlockDominatesOn(bb, succ)) {
+            loop->isIrreducible_ = true;
+        }
+    }
+
+    // header of an inner loop is visited after the header of the outer one
+    for (auto *bb : preorderBlocks) {
+        if (headerLoops[bb->GetId()] != nullptr) {
+            loops_.push_back(headerLoops[bb->GetId()]);
+        }
+    }
+}
+
+void LoopAnalysis::PopulateLoop(Loop *loop)
+{
+    auto *header = loop->header_;
+    auto headerPreorder = preorders_[header->GetId()];
+    auto lastDescendant = lastDescendants_[header->GetId()];
+    ASSERT(blockLoops_[header->GetId()] == nullptr);
+    blockLoops_[header->GetId()] = loop;
+    loop->blocks_.push_back(header);
+
+    // backward walk from the back edges stops at the header. Blocks of an irreducible loop are not dominated by
+    // the header, the walk is bounded by the dfs subtree of the header not to leave the loop through other entries
+    std::vector<BasicBlock *> worklist(loop->backEdges_.begin(), loop->backEdges_.end());
+    while (!worklist.empty()) {
+        auto *bb = worklist.back();
+        worklist.pop_back();
+        auto preorder = preorders_[bb->GetId()];
+        if (preorder == InvalidIdx || preorder < headerPreorder || preorder > lastDescendant) {
+            continue;
+        }
+
+        auto *bbLoop = blockLoops_[bb->GetId()];
+        if (bbLoop == nullptr) {
+            blockLoops_[bb->GetId()] = loop;
+            loop->blocks_.push_back(bb);
+            worklist.insert(worklist.end(), bb->GetPredecessors().begin(), bb->GetPredecessors().end());
+            continue;
+        }
+        // block of an inner loop, the whole outermost inner loop is added at once
+        auto *innerLoop = GetOutermostLoop(bbLoop);
+        if (innerLoop == loop) {
+            continue;
+        }
+        innerLoop->outerLoop_ = loop;
+        loop->innerLoops_.push_back(innerLoop);
+        auto &headerPreds = innerLoop->header_->GetPredecessors();
+        worklist.insert(worklist.end(), headerPreds.begin(), headerPreds.end());
+    }
+}
+
+Loop *LoopAnalysis::GetOutermostLoop(Loop *loop) const
+{
+    while (loop->outerLoop_ != nullptr) {
+        loop = loop->outerLoop_;
+    }
+    return loop;
+}
+
+void LoopAnalysis::ComputeDepths()
+{
+    // outer loops go first, the root loop has depth 0
+    for (auto *loop : loops_) {
+        loop->depth_ = loop->outerLoop_->depth_ + 1;
+    }
+}
+
+void LoopAnalysis::ComputePreHeader(Loop *loop)
+{
+    if (loop->isIrreducible_) {
+        return;
+    }
+    BasicBlock *preHeader = nullptr;
+    for (auto *pred : loop->header_->GetPredecessors()) {
+        auto *predLoop = GetLoop(pred);
+        if (predLoop == nullptr || loop->Contains(predLoop)) {
+            continue;
+        }
+        if (preHeader != nullptr) {
+            return;
+        }
+        preHeader = pred;
+    }
+    if (preHeader != nullptr && preHeader->GetSuccessor(1) == nullptr) {
+        loop->preHeader_ = preHeader;
+    }
+}
+
+void LoopAnalysis::ComputeExitBlocks()
+{
+    for (auto *loop : loops_) {
+        for (auto *bb : loop->blocks_) {
+            for (size_t succIdx = 0; succIdx < BasicBlock::MaxSuccessorsCount; ++succIdx) {
+                auto *succ = bb->GetSuccessor(succIdx);
+                if (succ == nullptr) {
+                    continue;
+                }
+                // the edge leaves every loop from the innermost one of the block up to the common outer loop
+                auto *exitLoop = loop;
+                auto *succLoop = GetLoop(succ);
+                while (succLoop->depth_ > exitLoop->depth_) {
+                    succLoop = succLoop->outerLoop_;
+                }
+                while (exitLoop != succLoop) {
+                    if (exitLoop->depth_ >= succLoop->depth_) {
+                        AddExitBlock(exitLoop, succ);
+                        exitLoop = exitLoop->outerLoop_;
+                    } else {
+                        succLoop = succLoop->outerLoop_;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* static */
+void LoopAnalysis::AddExitBlock(Loop *loop, BasicBlock *exitBlock)
+{
+    auto &exits = loop->exitBlocks_;
+    if (std::find(exits.begin(), exits.end(), exitBlock) == exits.end()) {
+        exits.push_back(exitBlock);
+    }
+}
+
+}  // namespace compiler
@@ -0,0 +1,176 @@
+#ifndef ANALYSIS_LOOP_ANALYSIS_H
+#define ANALYSIS_LOOP_ANALYSIS_H
+
+#include "analysis/analysis.h"
+#include "utils/macros.h"
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace compiler {
+
+class AnalysisManager;
+
+// Loop of the loop tree. The root loop is not a real loop, it holds blocks which are outside of all loops
+class Loop {
+public:
+    Loop(BasicBlock *header, uint32_t id) : header_(header), id_(id) {}
+
+    uint32_t GetId() const
+    {
+        return id_;
+    }
+
+    // nullptr for the root loop
+    BasicBlock *GetHeader() const
+    {
+        return header_;
+    }
+
+    // Single predecessor of the header from outside of the loop whose only successor is the header, nullptr if
+    // there is no such block
+    BasicBlock *GetPreHeader() const
+    {
+        return preHeader_;
+    }
+
+    // Sources of edges which go back to the header
+    const std::vector<BasicBlock *> &GetBackEdges() const
+    {
+        return backEdges_;
+    }
+
+    // Blocks whose innermost loop is this one, the header goes first
+    const std::vector<BasicBlock *> &GetBlocks() const
+    {
+        return blocks_;
+    }
+
+    // Blocks outside of the loop which are successors of blocks of the loop or its inner loops
+    const std::vector<BasicBlock *> &GetExitBlocks() const
+    {
+        return exitBlocks_;
+    }
+
+    // nullptr for the root loop
+    Loop *GetOuterLoop() const
+    {
+        return outerLoop_;
+    }
+
+    const std::vector<Loop *> &GetInnerLoops() const
+    {
+        return innerLoops_;
+    }
+
+    // 0 for the root loop, 1 for outermost loops
+    uint32_t GetDepth() const
+    {
+        return depth_;
+    }
+
+    bool IsRoot() const
+    {
+        return header_ == nullptr;
+    }
+
+    // Loop is entered not only through the header, its blocks are not dominated by the header
+    bool IsIrreducible() const
+    {
+        return isIrreducible_;
+    }
+
+    /// @return true if other is this loop or one of its inner loops
+    bool Contains(const Loop *other) const;
+
+private:
+    friend class LoopAnalysis;
+
+    BasicBlock *header_;
+    uint32_t id_;
+    BasicBlock *preHeader_ {nullptr};
+    std::vector<BasicBlock *> backEdges_;
+    std::vector<BasicBlock *> blocks_;
+    std::vector<BasicBlock *> exitBlocks_;
+    Loop *outerLoop_ {nullptr};
+    std::vector<Loop *> innerLoops_;
+    uint32_t depth_ {0};
+    bool isIrreducible_ {false};
+};
+
+/**
+ * Builds the loop tree in linear time. Retreating edges of depth first search go to loop headers, they are back
+ * edges of natural loops if the header dominates the source and make the loop irreducible otherwise. Loops are
+ * populated by backward walks from back edges, inner loops first, so every block is added to one loop only
+ */
+class LoopAnalysis {
+public:
+    static constexpr auto Type = AnalysisType::LOOP_ANALYSIS;
+
+    // Dominators are taken from the analysis manager, standalone analysis computes them by itself
+    explicit LoopAnalysis(Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(analysisManager)
+    {
+    }
+
+    void Run();
+
+    Loop *GetRootLoop() const
+    {
+        return rootLoop_;
+    }
+
+    // Loops except the root one, outer loops go before their inner loops
+    const std::vector<Loop *> &GetLoops() const
+    {
+        return loops_;
+    }
+
+    // Innermost loop of the block, the root loop for blocks outside of loops and nullptr for unreachable blocks
+    Loop *GetLoop(BasicBlock *bb) const;
+
+    // Dominators which the loops were computed with
+    const DominatorsTree &GetDominatorsTree() const
+    {
+        ASSERT(domTree_ != nullptr);
+        return *domTree_;
+    }
+
+private:
+    static constexpr uint32_t InvalidIdx = static_cast<uint32_t>(-1);
+
+    // Numbers blocks in dfs preorder and creates loops for targets of retreating edges
+    void CollectBackEdges();
+
+    // Adds blocks of the loop which are not in inner loops and links outermost inner loops to it
+    void PopulateLoop(Loop *loop);
+
+    void ComputeDepths();
+
+    void ComputePreHeader(Loop *loop);
+
+    void ComputeExitBlocks();
+
+    static void AddExitBlock(Loop *loop, BasicBlock *exitBlock);
+
+    Loop *GetOutermostLoop(Loop *loop) const;
+
+    Graph *graph_;
+    AnalysisManager *analysisManager_;
+    std::optional<DominatorsTree> ownDomTree_;
+    const DominatorsTree *domTree_ {nullptr};
+    std::deque<Loop> loopsStorage_;
+    Loop *rootLoop_ {nullptr};
+    std::vector<Loop *> loops_;
+    // indexed by block id
+    std::vector<Loop *> blockLoops_;
+    std::vector<uint32_t> preorders_;
+    // greatest preorder in the dfs subtree of the block
+    std::vector<uint32_t> lastDescendants_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_LOOP_ANALYSIS_H
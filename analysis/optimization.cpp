@@ -1,13 +1,20 @@
 #include "analysis/optimization.h"
 #include "analysis/analysis.h"
+#include "analysis/induction_analysis.h"
+#include "analysis/pattern_match.h"
+#include "analysis/range_analysis.h"
+#include "analysis/statistics.h"
 #include "ir/basic_block.h"
 #include "ir/common.h"
 #include "ir/id.h"
 #include "ir/instruction.h"
 #include "ir/graph.h"
 
+#include <algorithm>
 #include <deque>
+#include <functional>
 #include <unordered_map>
+#include <utility>
 
 namespace compiler {
 
@@ -15,39 +22,89 @@ namespace {
 
 ir::Instruction *CreateConstInst(ir::Graph *graph, ir::ResultType resType, int64_t constValue)
 {
-    auto *constBlock = graph->GetStartBlock();
-    ir::Instruction *constInst = nullptr;
-    constBlock->IterateOverInstructions([&constInst, constValue](ir::Instruction *inst) {
-        if (inst->GetOpcode() == ir::Opcode::CONSTANT) {
-            if (inst->As<ir::AssignInst>()->GetValue() == constValue) {
-                constInst = inst;
-                return true;
-            }
-        }
-        return false;
-    });
+    auto *constInst = graph->FindConstant(resType, constValue);
     if (constInst == nullptr) {
-        constInst =
-            new ir::AssignInst(constBlock, ir::InstId {graph->NewInstId()}, ir::Opcode::CONSTANT, resType, constValue);
+        auto *constBlock = graph->GetStartBlock();
+        constInst = graph->GetAllocator()->New<ir::AssignInst>(constBlock, ir::InstId {graph->NewInstId()},
+                                                               ir::Opcode::CONSTANT, resType, constValue);
         constInst->InsertInstBefore(constBlock->GetLastInstruction());
+        graph->RegisterConstant(constInst);
     }
     return constInst;
 }
 
+// Integer arithmetic wraps around, it is performed on unsigned values to avoid undefined behaviour
+int64_t WrapAdd(int64_t op1, int64_t op2)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(op1) + static_cast<uint64_t>(op2));
+}
+
+int64_t WrapMul(int64_t op1, int64_t op2)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(op1) * static_cast<uint64_t>(op2));
+}
+
+// Creates `op1 opcode op2` of the instruction result type in front of it
+ir::Instruction *CreateArithmInst(ir::Instruction *inst, ir::InstId instId, ir::Opcode opcode, ir::Instruction *op1,
+                                  ir::Instruction *op2)
+{
+    auto *bb = inst->GetBasicBlock();
+    auto *arithmInst = bb->GetGraph()->GetAllocator()->New<ir::ArithmInst>(bb, instId, opcode, inst->GetResultType(),
+                                                                          ir::InstProxyList {op1, op2});
+    arithmInst->InsertInstBefore(inst);
+    return arithmInst;
+}
+
+// Creates `op1 opcode op2` of the given type in front of the instruction
+ir::Instruction *CreateArithmInst(ir::Instruction *inst, ir::ResultType resType, ir::Opcode opcode,
+                                  ir::Instruction *op1, ir::Instruction *op2)
+{
+    auto *bb = inst->GetBasicBlock();
+    auto *graph = bb->GetGraph();
+    auto *arithmInst = graph->GetAllocator()->New<ir::ArithmInst>(bb, ir::InstId {graph->NewInstId()}, opcode,
+                                                                  resType, ir::InstProxyList {op1, op2});
+    arithmInst->InsertInstBefore(inst);
+    return arithmInst;
+}
+
+ir::Instruction *CreateShlInst(ir::Instruction *inst, ir::InstId instId, ir::Instruction *value, uint32_t shift)
+{
+    auto *shiftInst = CreateConstInst(inst->GetBasicBlock()->GetGraph(), ir::ResultType::U8, shift);
+    return CreateArithmInst(inst, instId, ir::Opcode::SHL, value, shiftInst);
+}
+
 ir::Instruction *CreatePhi(ir::BasicBlock *insertionPoint, ir::ResultType resType)
 {
     auto *graph = insertionPoint->GetGraph();
     auto instId = ir::InstId {graph->NewInstId(), true};
-    auto *phiInst = new ir::PhiInst {insertionPoint, instId, resType};
+    auto *phiInst = graph->GetAllocator()->New<ir::PhiInst>(insertionPoint, instId, resType);
     insertionPoint->InsertPhiInst(phiInst);
     return phiInst;
 }
 
+void UpdatePhisIncomingBlock(ir::BasicBlock *bb, ir::BasicBlock *oldBB, ir::BasicBlock *newBB)
+{
+    bb->IterateOverInstructions([oldBB, newBB](ir::Instruction *inst) {
+        // phis are placed at the beginning of the block
+        if (inst->GetOpcode() != ir::Opcode::PHI) {
+            return true;
+        }
+        auto *phi = inst->As<ir::PhiInst>();
+        for (size_t idx = 0; idx < phi->GetInputs().Size(); ++idx) {
+            if (phi->GetIncomingBlock(idx) == oldBB) {
+                phi->SetIncomingBlock(idx, newBB);
+            }
+        }
+        return false;
+    });
+}
+
 ir::Instruction *CreateBr(ir::BasicBlock *insertionPoint)
 {
     auto *graph = insertionPoint->GetGraph();
     auto instId = ir::InstId {graph->NewInstId(), false};
-    auto *brInst = new ir::BranchInst {insertionPoint, instId, ir::Opcode::BRANCH, ir::InstProxyList {}};
+    auto *brInst =
+        graph->GetAllocator()->New<ir::BranchInst>(insertionPoint, instId, ir::Opcode::BRANCH, ir::InstProxyList {});
     insertionPoint->InsertInstBack(brInst);
     return brInst;
 }
@@ -60,182 +117,326 @@ PeepHoleOptimizer::OptimizerMap PeepHoleOptimizer::CreateOptimizers()
     OptimizerMap optimizers {};
     optimizers.fill(OptimizeStub);
     optimizers[ir::OpcodeToIndex<ir::Opcode::ADD>()] = OptimizeAdd;
+    optimizers[ir::OpcodeToIndex<ir::Opcode::MUL>()] = OptimizeMul;
     optimizers[ir::OpcodeToIndex<ir::Opcode::SHL>()] = OptimizeShl;
     optimizers[ir::OpcodeToIndex<ir::Opcode::XOR>()] = OptimizeXor;
     optimizers[ir::OpcodeToIndex<ir::Opcode::PHI>()] = OptimizePhi;
     return optimizers;
 }
 
-void PeepHoleOptimizer::Run()
+bool PeepHoleOptimizer::Run()
 {
-    RPO rpo(graph_);
-    rpo.Run();
-    for (auto *bb : rpo.GetRpoVector()) {
-        bb->IterateOverInstructions([](ir::Instruction *inst) {
-            auto *optimizer = OpcodeToOptimizer[ir::OpcodeToIndex(inst->GetOpcode())];
-            optimizer(inst);
+    PassScope passScope {graph_, "PeepHoleOptimizer"};
+    isChanged_ = false;
+    // inputs precede their users in rpo except values which reach phis by back edges, so a single sweep visits
+    // almost every user after its inputs are optimized. The rest of users are revisited from the worklist
+    for (auto *bb : analysisManager_->GetAnalysis<RPO>().GetRpoVector()) {
+        bb->IterateOverInstructions([this](ir::Instruction *inst) {
+            // instruction from the worklist is optimized after the sweep
+            if (!IsInWorklist(inst)) {
+                Optimize(inst, true);
+            }
             return false;
         });
     }
+    while (!worklist_.empty()) {
+        auto *inst = worklist_.back();
+        worklist_.pop_back();
+        inWorklist_[inst->GetInstId().GetId()] = false;
+        Optimize(inst, false);
+    }
+    inWorklist_.clear();
+    return isChanged_;
+}
+
+void PeepHoleOptimizer::Optimize(ir::Instruction *inst, bool isSweep)
+{
+    auto *optimizer = OpcodeToOptimizer[ir::OpcodeToIndex(inst->GetOpcode())];
+    auto instIdsBound = graph_->GetInstIdsBound();
+    auto *newInst = optimizer(inst);
+    if (newInst == nullptr) {
+        return;
+    }
+    isChanged_ = true;
+    // instruction changed in place may match other rules
+    while (newInst == inst) {
+        PushUsersToWorklist(inst, isSweep);
+        newInst = optimizer(inst);
+        if (newInst == nullptr) {
+            return;
+        }
+    }
+    PushUsersToWorklist(inst, isSweep);
+    // replacement and its inputs may be created by the rule in front of the sweep position
+    PushToWorklist(newInst);
+    for (auto *input : newInst->GetInputs()) {
+        if (input->GetInstId().GetId() >= instIdsBound) {
+            PushToWorklist(input);
+        }
+    }
+    ir::Instruction::UpdateUsersAndEliminate(inst, newInst);
+}
+
+void PeepHoleOptimizer::PushUsersToWorklist(ir::Instruction *inst, bool isSweep)
+{
+    // users get new inputs and may be optimized further, the sweep visits all of them except phis by itself
+    for (auto *user : inst->GetUsers()) {
+        if (user != inst && (!isSweep || user->GetOpcode() == ir::Opcode::PHI)) {
+            PushToWorklist(user);
+        }
+    }
+}
+
+void PeepHoleOptimizer::PushToWorklist(ir::Instruction *inst)
+{
+    if (OpcodeToOptimizer[ir::OpcodeToIndex(inst->GetOpcode())] == OptimizeStub || IsInWorklist(inst)) {
+        return;
+    }
+    auto id = inst->GetInstId().GetId();
+    if (id >= inWorklist_.size()) {
+        // instructions created by the pass have new ids
+        inWorklist_.resize(std::max<size_t>(id + 1, graph_->GetInstIdsBound()));
+    }
+    inWorklist_[id] = true;
+    worklist_.push_back(inst);
+}
+
+bool PeepHoleOptimizer::IsInWorklist(ir::Instruction *inst) const
+{
+    auto id = inst->GetInstId().GetId();
+    return id < inWorklist_.size() && inWorklist_[id];
 }
 
 /* static */
-PeepHoleOptimizer::OptStatus PeepHoleOptimizer::OptimizeConstArithm(ir::ArithmInst *inst, BothConstOpt bothConstOpt,
-                                                                    FirstConstOpt firstConstOpt,
-                                                                    SecondConstOpt secondConstOpt)
-{
-    auto [op1Const, op2Const] = inst->CheckInputsAreConst();
-    if (!op1Const && !op2Const) {
-        return OptStatus::NO_OPT;
-    }
-    ir::Instruction *newInst = nullptr;
-    auto *op1 = inst->GetFirstOp();
-    auto *op2 = inst->GetLastOp();
-    if (op1Const && op2Const) {
-        auto constValue = bothConstOpt(op1->As<ir::AssignInst>()->GetValue(), op2->As<ir::AssignInst>()->GetValue());
-        newInst = CreateConstInst(inst->GetBasicBlock()->GetGraph(), ir::CombineResultType(op1, op2), constValue);
-    } else {
-        newInst = op1Const ? firstConstOpt(op1->As<ir::AssignInst>()->GetValue(), inst)
-                           : secondConstOpt(inst, op2->As<ir::AssignInst>()->GetValue());
+ir::Instruction *PeepHoleOptimizer::Fold(ir::Instruction *inst, int64_t value)
+{
+    auto *graph = inst->GetBasicBlock()->GetGraph();
+    CountStatistic(graph, StatCounter::FOLDED_CONSTANTS);
+    // folded values wrap around like the instruction does
+    return CreateConstInst(graph, inst->GetResultType(), ir::WrapToResultType(inst->GetResultType(), value));
+}
+
+/* static */
+ir::Instruction *PeepHoleOptimizer::Simplify(ir::Instruction *inst, ir::Instruction *newInst)
+{
+    CountStatistic(inst->GetBasicBlock()->GetGraph(), StatCounter::SIMPLIFIED_INSTS);
+    return newInst;
+}
+
+/* static */
+ir::Instruction *PeepHoleOptimizer::SimplifyToConst(ir::Instruction *inst, int64_t value)
+{
+    return Simplify(inst, CreateConstInst(inst->GetBasicBlock()->GetGraph(), inst->GetResultType(), value));
+}
+
+/* static */
+ir::Instruction *PeepHoleOptimizer::Reassociate(ir::Instruction *inst, ir::Instruction *value, int64_t constValue)
+{
+    CountStatistic(inst->GetBasicBlock()->GetGraph(), StatCounter::SIMPLIFIED_INSTS);
+    inst->SetInput(0, value);
+    auto resType = inst->GetResultType();
+    inst->SetInput(1, CreateConstInst(inst->GetBasicBlock()->GetGraph(), resType,
+                                      ir::WrapToResultType(resType, constValue)));
+    return inst;
+}
+
+/* static */
+bool PeepHoleOptimizer::CanonicalizeCommutative(ir::Instruction *inst)
+{
+    // constant goes to the right, so rules and value numbering see a single form
+    auto *op1 = inst->GetInput(0);
+    auto *op2 = inst->GetInput(1);
+    if (op1->GetOpcode() != ir::Opcode::CONSTANT || op2->GetOpcode() == ir::Opcode::CONSTANT) {
+        return false;
+    }
+    inst->SetInput(0, op2);
+    inst->SetInput(1, op1);
+    return true;
+}
+
+/* static */
+ir::Instruction *PeepHoleOptimizer::OptimizeAdd(ir::Instruction *addInst)
+{
+    ir::Instruction *x = nullptr;
+    int64_t c1 = 0;
+    int64_t c2 = 0;
+    if (pattern::Add(pattern::AnyConst(&c1), pattern::AnyConst(&c2)).Match(addInst)) {
+        return Fold(addInst, WrapAdd(c1, c2));
+    }
+    if (CanonicalizeCommutative(addInst)) {
+        return addInst;
+    }
+    if (pattern::Add(pattern::Value(&x), pattern::Const(0)).Match(addInst)) {
+        return Simplify(addInst, x);
     }
-    if (newInst != nullptr) {
-        ir::Instruction::UpdateUsersAndEliminate(inst, newInst);
-        return OptStatus::OPT;
+    // (x + c1) + c2 -> x + (c1 + c2)
+    if (pattern::Add(pattern::Add(pattern::Value(&x), pattern::AnyConst(&c1)), pattern::AnyConst(&c2)).Match(addInst)) {
+        return Reassociate(addInst, x, WrapAdd(c1, c2));
     }
-    return OptStatus::CANT_OPT;
+    // x + x -> x << 1
+    if (pattern::Add(pattern::Value(&x), pattern::Same(&x)).Match(addInst)) {
+        auto *shlInst = CreateShlInst(addInst, addInst->GetInstId(), x, 1U);
+        return Simplify(addInst, shlInst);
+    }
+    return nullptr;
 }
 
 /* static */
-PeepHoleOptimizer::OptStatus PeepHoleOptimizer::OptimizeSameInputs(ir::ArithmInst *inst, SameInputsOpt sameInputsOpt)
+ir::Instruction *PeepHoleOptimizer::OptimizeMul(ir::Instruction *mulInst)
 {
-    if (inst->GetFirstOp() != inst->GetLastOp()) {
-        return OptStatus::NO_OPT;
+    ir::Instruction *x = nullptr;
+    int64_t c1 = 0;
+    int64_t c2 = 0;
+    if (pattern::Mul(pattern::AnyConst(&c1), pattern::AnyConst(&c2)).Match(mulInst)) {
+        return Fold(mulInst, WrapMul(c1, c2));
+    }
+    if (CanonicalizeCommutative(mulInst)) {
+        return mulInst;
     }
-    auto *newInst = sameInputsOpt(inst);
-    if (newInst != nullptr) {
-        ir::Instruction::UpdateUsersAndEliminate(inst, newInst);
-        return OptStatus::OPT;
+    // (x * c1) * c2 -> x * (c1 * c2)
+    if (pattern::Mul(pattern::Mul(pattern::Value(&x), pattern::AnyConst(&c1)), pattern::AnyConst(&c2)).Match(mulInst)) {
+        return Reassociate(mulInst, x, WrapMul(c1, c2));
     }
-    return OptStatus::CANT_OPT;
+    if (pattern::Mul(pattern::Value(&x), pattern::AnyConst(&c1)).Match(mulInst)) {
+        return ReduceMulByConst(mulInst, x, c1);
+    }
+    return nullptr;
 }
 
 /* static */
-void PeepHoleOptimizer::OptimizeAdd(ir::Instruction *addInst)
+ir::Instruction *PeepHoleOptimizer::ReduceMulByConst(ir::Instruction *mulInst, ir::Instruction *value,
+                                                     int64_t constValue)
 {
-    auto bothConst = [](int64_t op1, int64_t op2) { return op1 + op2; };
-    auto firstConst = [](int64_t op1, ir::Instruction *inst) {
-        if (op1 == 0) {
-            return inst->GetLastOp();
-        }
-        return ir::Instruction::EmptyInst;
-    };
-    auto secondConst = [](ir::Instruction *inst, int64_t op2) {
-        if (op2 == 0) {
-            return inst->GetFirstOp();
-        }
-        return ir::Instruction::EmptyInst;
-    };
-    auto sameInputsOpt = [](ir::Instruction *inst) {
-        auto bb = inst->GetBasicBlock();
-        auto *graph = bb->GetGraph();
-        auto *constOne = CreateConstInst(graph, ir::ResultType::U8, 1U);
-        auto newInst = new ir::ArithmInst(bb, inst->GetInstId(), ir::Opcode::SHL, inst->GetResultType(),
-                                          {inst->GetFirstOp(), constOne});
-        newInst->InsertInstBefore(inst);
-        return newInst->As<ir::Instruction>();
-    };
-    auto status = OptimizeConstArithm(addInst->As<ir::ArithmInst>(), bothConst, firstConst, secondConst);
-    if (status == OptStatus::NO_OPT) {
-        status = OptimizeSameInputs(addInst->As<ir::ArithmInst>(), sameInputsOpt);
+    // only the low bits of the constant affect the result of the type width
+    auto bits = ir::GetResultTypeBits(mulInst->GetResultType());
+    auto mask = bits < 64U ? (uint64_t {1} << bits) - 1U : ~uint64_t {0};
+    auto multiplier = static_cast<uint64_t>(constValue) & mask;
+    if (multiplier == 0) {
+        return SimplifyToConst(mulInst, 0);
+    }
+    if (multiplier == 1) {
+        return Simplify(mulInst, value);
+    }
+    auto lowShift = static_cast<uint32_t>(__builtin_ctzll(multiplier));
+    // x * 2^n -> x << n
+    if ((multiplier & (multiplier - 1U)) == 0) {
+        return Simplify(mulInst, CreateShlInst(mulInst, mulInst->GetInstId(), value, lowShift));
+    }
+    // x * (2^n + 2^m) -> (x << n) + (x << m), the rest of constants are cheaper to multiply
+    auto highPart = multiplier & (multiplier - 1U);
+    if ((highPart & (highPart - 1U)) != 0) {
+        return nullptr;
     }
+    auto *graph = mulInst->GetBasicBlock()->GetGraph();
+    auto highShift = static_cast<uint32_t>(__builtin_ctzll(highPart));
+    auto *highInst = CreateShlInst(mulInst, ir::InstId {graph->NewInstId()}, value, highShift);
+    auto *lowInst = lowShift == 0 ? value : CreateShlInst(mulInst, ir::InstId {graph->NewInstId()}, value, lowShift);
+    return Simplify(mulInst, CreateArithmInst(mulInst, mulInst->GetInstId(), ir::Opcode::ADD, highInst, lowInst));
 }
 
 /* static */
-void PeepHoleOptimizer::OptimizeShl(ir::Instruction *shlInst)
+ir::Instruction *PeepHoleOptimizer::OptimizeShl(ir::Instruction *shlInst)
 {
-    auto bothConst = [](int64_t op1, int64_t op2) { return op1 << op2; };
-    auto firstConst = [](int64_t op1, ir::Instruction *inst) {
-        if (op1 == 0) {
-            return CreateConstInst(inst->GetBasicBlock()->GetGraph(), ir::ResultType::U8, 0);
-        }
-        return ir::Instruction::EmptyInst;
-    };
-    auto secondConst = [](ir::Instruction *inst, int64_t op2) {
-        if (op2 == 0) {
-            return inst->GetFirstOp();
-        }
-        return ir::Instruction::EmptyInst;
-    };
-    [[maybe_unused]] auto _ = OptimizeConstArithm(shlInst->As<ir::ArithmInst>(), bothConst, firstConst, secondConst);
+    ir::Instruction *x = nullptr;
+    int64_t c1 = 0;
+    int64_t c2 = 0;
+    auto bits = static_cast<int64_t>(ir::GetResultTypeBits(shlInst->GetResultType()));
+    // shifts by the type width or more are left as is
+    auto isShiftInRange = [bits](int64_t shift) { return 0 <= shift && shift < bits; };
+    if (pattern::Shl(pattern::AnyConst(&c1), pattern::AnyConst(&c2)).Match(shlInst)) {
+        return isShiftInRange(c2) ? Fold(shlInst, static_cast<int64_t>(static_cast<uint64_t>(c1) << c2)) : nullptr;
+    }
+    if (pattern::Shl(pattern::Value(&x), pattern::Const(0)).Match(shlInst)) {
+        return Simplify(shlInst, x);
+    }
+    if (pattern::Shl(pattern::Const(0), pattern::Any()).Match(shlInst)) {
+        return SimplifyToConst(shlInst, 0);
+    }
+    // (x << c1) << c2 -> x << (c1 + c2)
+    if (pattern::Shl(pattern::Shl(pattern::Value(&x), pattern::AnyConst(&c1)), pattern::AnyConst(&c2)).Match(shlInst) &&
+        isShiftInRange(c1) && isShiftInRange(c2) && isShiftInRange(c1 + c2)) {
+        return Reassociate(shlInst, x, c1 + c2);
+    }
+    return nullptr;
 }
 
 /* static */
-void PeepHoleOptimizer::OptimizeXor(ir::Instruction *xorInst)
+ir::Instruction *PeepHoleOptimizer::OptimizeXor(ir::Instruction *xorInst)
 {
-    auto bothConst = [](int64_t op1, int64_t op2) { return op1 ^ op2; };
-    auto firstConst = [](int64_t op1, ir::Instruction *inst) {
-        if (op1 == 0) {
-            return inst->GetLastOp();
-        }
-        return ir::Instruction::EmptyInst;
-    };
-    auto secondConst = [](ir::Instruction *inst, int64_t op2) {
-        if (op2 == 0) {
-            return inst->GetFirstOp();
-        }
-        return ir::Instruction::EmptyInst;
-    };
-    auto sameInputsOpt = [](ir::Instruction *inst) {
-        return CreateConstInst(inst->GetBasicBlock()->GetGraph(), ir::ResultType::U8, 0);
-    };
-    auto status = OptimizeConstArithm(xorInst->As<ir::ArithmInst>(), bothConst, firstConst, secondConst);
-    if (status == OptStatus::NO_OPT) {
-        status = OptimizeSameInputs(xorInst->As<ir::ArithmInst>(), sameInputsOpt);
+    ir::Instruction *x = nullptr;
+    ir::Instruction *y = nullptr;
+    int64_t c1 = 0;
+    int64_t c2 = 0;
+    if (pattern::Xor(pattern::AnyConst(&c1), pattern::AnyConst(&c2)).Match(xorInst)) {
+        return Fold(xorInst, c1 ^ c2);
+    }
+    if (CanonicalizeCommutative(xorInst)) {
+        return xorInst;
+    }
+    if (pattern::Xor(pattern::Value(&x), pattern::Const(0)).Match(xorInst)) {
+        return Simplify(xorInst, x);
     }
+    if (pattern::Xor(pattern::Value(&x), pattern::Same(&x)).Match(xorInst)) {
+        return SimplifyToConst(xorInst, 0);
+    }
+    // (x ^ c1) ^ c2 -> x ^ (c1 ^ c2)
+    if (pattern::Xor(pattern::Xor(pattern::Value(&x), pattern::AnyConst(&c1)), pattern::AnyConst(&c2)).Match(xorInst)) {
+        return Reassociate(xorInst, x, c1 ^ c2);
+    }
+    // (x ^ y) ^ y -> x, both inputs of the inner xor are tried as y
+    if (pattern::Xor(pattern::Xor(pattern::Value(&x), pattern::Value(&y)), pattern::Same(&y)).Match(xorInst) ||
+        pattern::Xor(pattern::Xor(pattern::Value(&y), pattern::Value(&x)), pattern::Same(&y)).Match(xorInst)) {
+        return Simplify(xorInst, x);
+    }
+    return nullptr;
 }
 
 /* static */
-void PeepHoleOptimizer::OptimizePhi(ir::Instruction *phiInst)
+ir::Instruction *PeepHoleOptimizer::OptimizePhi(ir::Instruction *phiInst)
 {
-    if (phiInst->As<ir::PhiInst>()->HasOnlyOneDependency()) {
-        auto *valueDep = phiInst->As<ir::PhiInst>()->GetValueDependencies().begin()->first;
-        ir::Instruction::UpdateUsersAndEliminate(phiInst, valueDep);
+    if (!phiInst->As<ir::PhiInst>()->HasOnlyOneDependency()) {
+        return nullptr;
     }
+    return Simplify(phiInst, phiInst->GetFirstOp());
 }
 
-void CheckOptimizer::Run()
+bool CheckOptimizer::Run()
 {
-    DominatorsTree domTree(graph_);
-    domTree.Run();
+    PassScope passScope {graph_, "CheckOptimizer"};
+    const auto &domTree = analysisManager_->GetAnalysis<DominatorsTree>();
 
-    auto eliminateDominatedChecks = [&domTree](std::deque<ir::Instruction *> &cheks, OptimizerPredicate pred) {
+    size_t eliminatedCount = 0;
+    auto eliminateDominatedChecks = [&domTree, &eliminatedCount](std::deque<ir::Instruction *> &cheks,
+                                                                 OptimizerPredicate pred) {
         while (!cheks.empty()) {
             auto *check = cheks.front();
             cheks.pop_front();
             for (auto otherCheckIt = cheks.begin(); otherCheckIt != cheks.end();) {
-                if (pred(check, *otherCheckIt)) {
-                    if (domTree.DoesInstructionDominatesOn(*otherCheckIt, check)) {
-                        Instruction::Eliminate(*otherCheckIt);
-                        otherCheckIt = cheks.erase(otherCheckIt);
-                        continue;
-                    } else if (domTree.DoesInstructionDominatesOn(check, *otherCheckIt)) {
-                        Instruction::Eliminate(check);
-                        break;
-                    }
+                if (domTree.DoesInstructionDominatesOn(*otherCheckIt, check) && pred(check, *otherCheckIt)) {
+                    ++eliminatedCount;
+                    Instruction::Eliminate(*otherCheckIt);
+                    otherCheckIt = cheks.erase(otherCheckIt);
+                    continue;
+                }
+                if (domTree.DoesInstructionDominatesOn(check, *otherCheckIt) && pred(*otherCheckIt, check)) {
+                    ++eliminatedCount;
+                    Instruction::Eliminate(check);
+                    break;
                 }
                 ++otherCheckIt;
             }
         }
     };
 
-    RPO rpo(graph_);
-    rpo.Run();
-
-    for (auto *bb : rpo.GetRpoVector()) {
-        bb->IterateOverInstructions([&eliminateDominatedChecks](ir::Instruction *inst) {
+    std::vector<ir::Instruction *> knownCountMems;
+    for (auto *bb : analysisManager_->GetAnalysis<RPO>().GetRpoVector()) {
+        bb->IterateOverInstructions([&eliminateDominatedChecks, &knownCountMems](ir::Instruction *inst) {
             if (inst->GetOpcode() != ir::Opcode::MEM) {
                 return false;
             }
+            if (inst->GetFirstOp()->GetOpcode() == ir::Opcode::CONSTANT) {
+                knownCountMems.push_back(inst);
+            }
             std::unordered_map<ir::CheckType, std::deque<ir::Instruction *>> checks;
             for (auto *user : inst->GetUsers()) {
                 if (user->GetOpcode() == ir::Opcode::CHECK) {
@@ -248,6 +449,126 @@ void CheckOptimizer::Run()
             return false;
         });
     }
+    eliminatedCount += EliminateLoopBoundChecks();
+    eliminatedCount += EliminateInRangeBoundChecks(knownCountMems);
+    CountStatistic(graph_, StatCounter::ELIMINATED_CHECKS, eliminatedCount);
+    return eliminatedCount != 0;
+}
+
+size_t CheckOptimizer::EliminateLoopBoundChecks()
+{
+    auto &loopAnalysis = analysisManager_->GetAnalysis<LoopAnalysis>();
+    if (loopAnalysis.GetLoops().empty()) {
+        return 0;
+    }
+    const auto &domTree = analysisManager_->GetAnalysis<DominatorsTree>();
+
+    std::vector<ir::Instruction *> inBoundsChecks;
+    for (auto *loop : loopAnalysis.GetLoops()) {
+        if (loop->IsIrreducible() || loop->GetBackEdges().size() != 1) {
+            continue;
+        }
+        loop->GetHeader()->IterateOverInstructions([loop, &domTree, &inBoundsChecks](ir::Instruction *inst) {
+            // phis are placed at the beginning of the block
+            if (inst->GetOpcode() != ir::Opcode::PHI) {
+                return true;
+            }
+            for (auto *user : inst->GetUsers()) {
+                if (user->GetOpcode() == ir::Opcode::CHECK &&
+                    user->As<ir::CheckInst>()->GetCheckType() == ir::CheckType::BOUND && user->GetLastOp() == inst &&
+                    IsIndexInBounds(user, inst, loop, domTree)) {
+                    inBoundsChecks.push_back(user);
+                }
+            }
+            return false;
+        });
+    }
+    for (auto *check : inBoundsChecks) {
+        Instruction::Eliminate(check);
+    }
+    return inBoundsChecks.size();
+}
+
+size_t CheckOptimizer::EliminateInRangeBoundChecks(const std::vector<ir::Instruction *> &knownCountMems)
+{
+    auto rangeAnalysis = RangeAnalysis {graph_, analysisManager_.Get()};
+    bool isAnalysed = false;
+
+    std::vector<ir::Instruction *> inRangeChecks;
+    for (auto *mem : knownCountMems) {
+        auto count = mem->GetFirstOp()->As<ir::AssignInst>()->GetValue();
+        for (auto *check : mem->GetUsers()) {
+            if (check->GetOpcode() != ir::Opcode::CHECK ||
+                check->As<ir::CheckInst>()->GetCheckType() != ir::CheckType::BOUND) {
+                continue;
+            }
+            auto *idxInst = check->GetLastOp();
+            int64_t idx = 0;
+            auto idxRange = ValueRange {};
+            if (pattern::AnyConst(&idx).Match(idxInst)) {
+                idxRange = {idx, idx};
+            } else {
+                // ranges are computed only if memory of known size is accessed by unknown indices
+                if (!isAnalysed) {
+                    rangeAnalysis.Run();
+                    isAnalysed = true;
+                }
+                idxRange = rangeAnalysis.GetRange(idxInst, check->GetBasicBlock());
+            }
+            if (!idxRange.IsEmpty() && idxRange.IsInside({0, count - 1})) {
+                inRangeChecks.push_back(check);
+            }
+        }
+    }
+    for (auto *check : inRangeChecks) {
+        Instruction::Eliminate(check);
+    }
+    return inRangeChecks.size();
+}
+
+/* static */
+bool CheckOptimizer::IsIndexInBounds(ir::Instruction *checkInst, ir::Instruction *phiInst, Loop *loop,
+                                     const DominatorsTree &domTree)
+{
+    auto *mem = checkInst->GetFirstOp();
+    auto *phi = phiInst->As<ir::PhiInst>();
+    auto *latch = loop->GetBackEdges().front();
+    if (mem->GetOpcode() != ir::Opcode::MEM || phi->GetInputs().Size() != 2) {
+        return false;
+    }
+    auto latchIdx = phi->GetIncomingBlock(0) == latch ? 0U : 1U;
+    auto *init = phi->GetInput(1 - latchIdx);
+    auto *next = phi->GetInput(latchIdx);
+    int64_t initValue = 0;
+    if (phi->GetIncomingBlock(latchIdx) != latch || !pattern::AnyConst(&initValue).Match(init) || initValue < 0 ||
+        !pattern::Add(pattern::Specific(phiInst), pattern::Const(1)).Match(next)) {
+        return false;
+    }
+
+    auto *length = mem->GetFirstOp();
+    for (auto *cmpInst : phiInst->GetUsers()) {
+        if (!pattern::Compare(ir::CmpFlags::LT, pattern::Specific(phiInst), pattern::Specific(length))
+                 .Match(cmpInst)) {
+            continue;
+        }
+        for (auto *branchInst : cmpInst->GetUsers()) {
+            if (branchInst->GetOpcode() != ir::Opcode::COND_BRANCH) {
+                continue;
+            }
+            // the true edge is the only way to the block, so the index is less than length inside of it
+            auto *branchBB = branchInst->GetBasicBlock();
+            auto *inBoundsBB = branchBB->GetTrueSuccessor();
+            if (inBoundsBB == branchBB->GetFalseSuccessor() || inBoundsBB->GetPredecessors().size() != 1) {
+                continue;
+            }
+            // the index is compared on every iteration before it is incremented, so it never wraps around
+            if (domTree.DoesBlockDominatesOn(latch, inBoundsBB) &&
+                domTree.DoesBlockDominatesOn(checkInst->GetBasicBlock(), inBoundsBB)) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 /* static */
@@ -277,29 +598,31 @@ bool CheckOptimizer::OptimizePredBounds(ir::Instruction *boundsInst1, ir::Instru
     if (idx1 == idx2) {
         return true;
     }
-    if (idx1->GetOpcode() == ir::Opcode::CONSTANT && idx2->GetOpcode() == ir::Opcode::CONSTANT) {
-        return idx1->As<ir::AssignInst>()->GetValue() == idx2->As<ir::AssignInst>()->GetValue();
-    }
-    return false;
+    // the length is greater than the first index, so it is greater than every smaller non-negative index
+    int64_t c1 = 0;
+    int64_t c2 = 0;
+    return pattern::AnyConst(&c1).Match(idx1) && pattern::AnyConst(&c2).Match(idx2) && 0 <= c2 && c2 <= c1;
 }
 
-void InliningOptimizer::Run()
+bool InliningOptimizer::Run()
 {
-    RPO rpo(graph_);
-    rpo.Run();
-
-    graph_->IterateOverBlocks([graph = graph_](ir::BasicBlock *bb) {
-        bb->IterateOverInstructions([graph](ir::Instruction *inst) {
+    PassScope passScope {graph_, "InliningOptimizer"};
+    size_t inlinedCount = 0;
+    graph_->IterateOverBlocks([graph = graph_, &inlinedCount](ir::BasicBlock *bb) {
+        bb->IterateOverInstructions([graph, &inlinedCount](ir::Instruction *inst) {
             if (inst->GetOpcode() == ir::Opcode::CALL_STATIC) {
                 auto *callInst = inst->As<ir::CallStaticInst>();
                 auto *calleeGraph = graph->GetGraphByMethodId(callInst->GetCalleeId());
                 auto [firstCalleeBB, postCallBB] = CloneCalleeGraph(callInst, calleeGraph);
                 MergeDataFLow(callInst, firstCalleeBB, postCallBB);
+                ++inlinedCount;
                 return true;
             }
             return false;
         });
     });
+    CountStatistic(graph_, StatCounter::INLINED_CALLS, inlinedCount);
+    return inlinedCount != 0;
 }
 
 /* static */
@@ -375,16 +698,13 @@ ir::BasicBlock *InliningOptimizer::UpdateDataFlowOfInlinedGraph(ir::CallStaticIn
         }
     }
     for (auto &[oldInst, newInst] : oldToNewInst) {
-        for (auto *oldUser : oldInst->GetUsers()) {
-            newInst->AddUsers(oldToNewInst[oldUser]);
-        }
+        // users of cloned instructions are linked by setting inputs
         if (oldInst->GetOpcode() == ir::Opcode::PHI) {
             ASSERT(newInst->GetOpcode() == ir::Opcode::PHI);
-            for (auto &[oldValue, oldBBs] : oldInst->As<ir::PhiInst>()->GetValueDependencies()) {
-                auto *newValue = oldToNewInst[oldValue];
-                for (auto *oldBB : oldBBs) {
-                    newInst->As<ir::PhiInst>()->ResolveDependency(newValue, oldToNewBB[oldBB]);
-                }
+            auto *oldPhi = oldInst->As<ir::PhiInst>();
+            for (size_t idx = 0; idx < oldPhi->GetInputs().Size(); ++idx) {
+                auto *newValue = oldToNewInst[oldPhi->GetInput(idx)];
+                newInst->As<ir::PhiInst>()->ResolveDependency(newValue, oldToNewBB[oldPhi->GetIncomingBlock(idx)]);
             }
         } else if (oldInst->GetOpcode() != ir::Opcode::RETURN) {
             for (auto *oldInput : oldInst->GetInputs()) {
@@ -406,17 +726,21 @@ void InliningOptimizer::MergeDataFLow(ir::CallStaticInst *callInst, ir::BasicBlo
     while (postCallInst != lastCallerInst) {
         postCallInst = callInst->Next()->AsItem();
         postCallInst->Unlink();
+        postCallInst->UpdateBasicBlock(postCallBB);
         if (postCallInst->GetOpcode() != ir::Opcode::PHI) {
             postCallBB->InsertInstBack(postCallInst);
         } else {
             postCallBB->InsertPhiInst(postCallInst);
         }
-        postCallInst->UpdateBasicBlock(postCallBB);
     }
 
     auto *callerBB = callInst->GetBasicBlock();
     callerBB->UpdateControlFlow(firstCalleeBB, nullptr, postCallBB);
     CreateBr(callerBB);
+    // successors of the caller block are reached from postCallBB now
+    for (auto *succ : postCallBB->GetSuccessors()) {
+        UpdatePhisIncomingBlock(succ, callerBB, postCallBB);
+    }
 
     if (replacingCallInst != nullptr) {
         ir::Instruction::UpdateUsersAndEliminate(callInst, replacingCallInst);
@@ -426,4 +750,909 @@ void InliningOptimizer::MergeDataFLow(ir::CallStaticInst *callInst, ir::BasicBlo
     }
 }
 
+bool GVNOptimizer::Run()
+{
+    PassScope passScope {graph_, "GVNOptimizer"};
+    // dominator tree is kept in the blocks
+    analysisManager_->GetAnalysis<DominatorsTree>();
+
+    // no rehashing while values are numbered, so iterators in scopeValues_ stay valid
+    values_.reserve(graph_->GetInstIdsBound());
+    size_t eliminatedCount = 0;
+    struct Frame {
+        ir::BasicBlock *bb;
+        // size of scopeValues_ before the block is numbered
+        size_t scopeBegin;
+        size_t nextDominatee;
+    };
+    std::vector<Frame> stack;
+    auto enterBlock = [this, &stack, &eliminatedCount](ir::BasicBlock *bb) {
+        stack.push_back({bb, scopeValues_.size(), 0});
+        bb->IterateOverInstructions([this, &eliminatedCount](ir::Instruction *inst) {
+            eliminatedCount += NumberValue(inst) ? 1 : 0;
+            return false;
+        });
+    };
+
+    enterBlock(graph_->GetStartBlock());
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        const auto &dominatees = frame.bb->GetImmediateDominatees();
+        if (frame.nextDominatee < dominatees.size()) {
+            enterBlock(dominatees[frame.nextDominatee++]);
+            continue;
+        }
+        // values of the block are not visible outside of its subtree
+        while (scopeValues_.size() > frame.scopeBegin) {
+            values_.erase(scopeValues_.back());
+            scopeValues_.pop_back();
+        }
+        stack.pop_back();
+    }
+    ASSERT(values_.empty());
+
+    CountStatistic(graph_, StatCounter::REDUNDANT_INSTS, eliminatedCount);
+    return eliminatedCount != 0;
+}
+
+bool GVNOptimizer::NumberValue(ir::Instruction *inst)
+{
+    if (!IsNumbered(inst)) {
+        return false;
+    }
+    auto [valueIt, isInserted] = values_.try_emplace(MakeKey(inst), inst);
+    if (isInserted) {
+        scopeValues_.push_back(valueIt);
+        return false;
+    }
+    // dominating instruction is numbered earlier
+    ir::Instruction::UpdateUsersAndEliminate(inst, valueIt->second);
+    return true;
+}
+
+/* static */
+bool GVNOptimizer::IsNumbered(ir::Instruction *inst)
+{
+    switch (inst->GetOpcode()) {
+        case ir::Opcode::CONSTANT:
+        case ir::Opcode::ADD:
+        case ir::Opcode::MUL:
+        case ir::Opcode::SHL:
+        case ir::Opcode::XOR:
+        case ir::Opcode::COMPARE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* static */
+GVNOptimizer::ValueKey GVNOptimizer::MakeKey(ir::Instruction *inst)
+{
+    auto key = ValueKey {};
+    key.opcode = inst->GetOpcode();
+    key.resType = inst->GetResultType();
+    switch (key.opcode) {
+        case ir::Opcode::CONSTANT:
+            key.constValue = inst->As<ir::AssignInst>()->GetValue();
+            return key;
+        case ir::Opcode::COMPARE:
+            key.cmpFlags = inst->As<ir::LogicInst>()->GetCmpFlags();
+            break;
+        default:
+            break;
+    }
+    key.op1 = inst->GetFirstOp();
+    key.op2 = inst->GetLastOp();
+    // inputs of commutative instructions are ordered, so `Add a, b` and `Add b, a` get the same key
+    auto isCommutative =
+        key.opcode == ir::Opcode::ADD || key.opcode == ir::Opcode::MUL || key.opcode == ir::Opcode::XOR;
+    if (isCommutative && key.op2->GetInstId().GetId() < key.op1->GetInstId().GetId()) {
+        std::swap(key.op1, key.op2);
+    }
+    return key;
+}
+
+bool GVNOptimizer::ValueKey::operator==(const ValueKey &other) const
+{
+    return opcode == other.opcode && resType == other.resType && cmpFlags == other.cmpFlags &&
+           constValue == other.constValue && op1 == other.op1 && op2 == other.op2;
+}
+
+size_t GVNOptimizer::ValueKeyHash::operator()(const ValueKey &key) const
+{
+    auto hash = std::hash<uint32_t> {}(static_cast<uint32_t>(key.opcode));
+    auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6U) + (hash >> 2U); };
+    combine(std::hash<uint32_t> {}(static_cast<uint32_t>(key.resType)));
+    combine(std::hash<uint32_t> {}(static_cast<uint32_t>(key.cmpFlags)));
+    combine(std::hash<int64_t> {}(key.constValue));
+    combine(std::hash<ir::Instruction *> {}(key.op1));
+    combine(std::hash<ir::Instruction *> {}(key.op2));
+    return hash;
+}
+
+bool DCEOptimizer::Run()
+{
+    PassScope passScope {graph_, "DCEOptimizer"};
+    auto removedBlocks = RemoveUnreachableBlocks();
+    if (removedBlocks != 0) {
+        analysisManager_->Invalidate();
+    }
+    auto removedInsts = RemoveDeadInstructions();
+    CountStatistic(graph_, StatCounter::REMOVED_BLOCKS, removedBlocks);
+    CountStatistic(graph_, StatCounter::REMOVED_INSTS, removedInsts);
+    return removedBlocks != 0 || removedInsts != 0;
+}
+
+size_t DCEOptimizer::RemoveUnreachableBlocks()
+{
+    const auto &rpo = analysisManager_->GetAnalysis<RPO>().GetRpoVector();
+    if (rpo.size() == graph_->GetBlocksCount()) {
+        return 0;
+    }
+    auto markerHolder = ir::MarkerHolder {graph_};
+    auto reachable = markerHolder.GetMarker();
+    for (auto *bb : rpo) {
+        bb->Mark(reachable);
+    }
+    std::vector<ir::BasicBlock *> unreachableBlocks;
+    graph_->IterateOverBlocks([reachable, &unreachableBlocks](ir::BasicBlock *bb) {
+        if (!bb->IsMarked(reachable)) {
+            unreachableBlocks.push_back(bb);
+        }
+    });
+    // values of unreachable blocks are used only by unreachable blocks and phis of their successors
+    graph_->RemoveBasicBlocks(unreachableBlocks);
+    return unreachableBlocks.size();
+}
+
+size_t DCEOptimizer::RemoveDeadInstructions()
+{
+    isLive_.assign(graph_->GetInstIdsBound(), false);
+    const auto &rpo = analysisManager_->GetAnalysis<RPO>().GetRpoVector();
+    for (auto *bb : rpo) {
+        bb->IterateOverInstructions([this](ir::Instruction *inst) {
+            if (HasSideEffects(inst)) {
+                MarkLive(inst);
+            }
+            return false;
+        });
+    }
+    while (!worklist_.empty()) {
+        auto *inst = worklist_.back();
+        worklist_.pop_back();
+        for (auto *input : inst->GetInputs()) {
+            MarkLive(input);
+        }
+    }
+
+    std::vector<ir::Instruction *> deadInsts;
+    for (auto *bb : rpo) {
+        bb->IterateOverInstructions([this, &deadInsts](ir::Instruction *inst) {
+            if (!isLive_[inst->GetInstId().GetId()]) {
+                deadInsts.push_back(inst);
+            }
+            return false;
+        });
+    }
+    // dead phis may form cycles with other dead instructions, the rest of users follow their inputs in rpo
+    for (auto *inst : deadInsts) {
+        if (inst->GetOpcode() == ir::Opcode::PHI) {
+            auto *phi = inst->As<ir::PhiInst>();
+            while (!phi->GetInputs().IsEmpty()) {
+                phi->RemoveDependency(phi->GetInputs().Size() - 1);
+            }
+        }
+    }
+    for (auto instIt = deadInsts.rbegin(); instIt != deadInsts.rend(); ++instIt) {
+        ir::Instruction::Eliminate(*instIt);
+    }
+    return deadInsts.size();
+}
+
+/* static */
+bool DCEOptimizer::HasSideEffects(ir::Instruction *inst)
+{
+    switch (inst->GetOpcode()) {
+        // parameters define the signature of the method
+        case ir::Opcode::PARAMETER:
+        case ir::Opcode::BRANCH:
+        case ir::Opcode::COND_BRANCH:
+        case ir::Opcode::RETURN:
+        case ir::Opcode::STORE:
+        case ir::Opcode::CHECK:
+        case ir::Opcode::CALL_STATIC:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void DCEOptimizer::MarkLive(ir::Instruction *inst)
+{
+    auto id = inst->GetInstId().GetId();
+    if (!isLive_[id]) {
+        isLive_[id] = true;
+        worklist_.push_back(inst);
+    }
+}
+
+bool SCCPOptimizer::Run()
+{
+    PassScope passScope {graph_, "SCCPOptimizer"};
+    values_.assign(graph_->GetInstIdsBound(), {});
+    isExecutable_.assign(graph_->GetBBIdsBound(), false);
+    executableEdges_.assign(graph_->GetBBIdsBound(), 0);
+
+    auto *startBB = graph_->GetStartBlock();
+    isExecutable_[startBB->GetId()] = true;
+    blockWorklist_.push_back(startBB);
+    Propagate();
+
+    auto foldedCount = FoldConstants();
+    auto foldedBranches = FoldBranches();
+    auto removedBlocks = RemoveNotExecutedBlocks();
+    if (foldedBranches != 0 || removedBlocks != 0) {
+        analysisManager_->Invalidate();
+    }
+    CountStatistic(graph_, StatCounter::FOLDED_CONSTANTS, foldedCount);
+    CountStatistic(graph_, StatCounter::FOLDED_BRANCHES, foldedBranches);
+    CountStatistic(graph_, StatCounter::REMOVED_BLOCKS, removedBlocks);
+    return foldedCount != 0 || foldedBranches != 0 || removedBlocks != 0;
+}
+
+void SCCPOptimizer::Propagate()
+{
+    while (!blockWorklist_.empty() || !instWorklist_.empty()) {
+        if (!blockWorklist_.empty()) {
+            auto *bb = blockWorklist_.back();
+            blockWorklist_.pop_back();
+            bb->IterateOverInstructions([this](ir::Instruction *inst) {
+                VisitInstruction(inst);
+                return false;
+            });
+            continue;
+        }
+        auto *inst = instWorklist_.back();
+        instWorklist_.pop_back();
+        // instructions of not executed blocks are visited when their block becomes executable
+        if (IsExecutable(inst->GetBasicBlock())) {
+            VisitInstruction(inst);
+        }
+    }
+}
+
+void SCCPOptimizer::MarkEdgeExecutable(ir::BasicBlock *bb, size_t succIdx)
+{
+    auto &edges = executableEdges_[bb->GetId()];
+    auto edgeBit = static_cast<uint8_t>(1U << succIdx);
+    if ((edges & edgeBit) != 0) {
+        return;
+    }
+    edges |= edgeBit;
+    auto *succ = bb->GetSuccessor(succIdx);
+    if (!IsExecutable(succ)) {
+        isExecutable_[succ->GetId()] = true;
+        blockWorklist_.push_back(succ);
+        return;
+    }
+    // the new edge brings a new input to phis
+    succ->IterateOverInstructions([this](ir::Instruction *inst) {
+        if (inst->GetOpcode() != ir::Opcode::PHI) {
+            return true;
+        }
+        instWorklist_.push_back(inst);
+        return false;
+    });
+}
+
+bool SCCPOptimizer::IsEdgeExecutable(ir::BasicBlock *pred, ir::BasicBlock *succ) const
+{
+    auto edges = executableEdges_[pred->GetId()];
+    for (size_t succIdx = 0; succIdx < ir::BasicBlock::MaxSuccessorsCount; ++succIdx) {
+        if ((edges & (1U << succIdx)) != 0 && pred->GetSuccessor(succIdx) == succ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SCCPOptimizer::IsExecutable(ir::BasicBlock *bb) const
+{
+    return isExecutable_[bb->GetId()];
+}
+
+void SCCPOptimizer::VisitInstruction(ir::Instruction *inst)
+{
+    auto opcode = inst->GetOpcode();
+    if (opcode == ir::Opcode::BRANCH || opcode == ir::Opcode::COND_BRANCH) {
+        VisitBranch(inst);
+        return;
+    }
+    auto newValue = Evaluate(inst);
+    auto &value = values_[inst->GetInstId().GetId()];
+    if (newValue == value) {
+        return;
+    }
+    ASSERT(newValue.state > value.state);
+    value = newValue;
+    for (auto *user : inst->GetUsers()) {
+        instWorklist_.push_back(user);
+    }
+}
+
+void SCCPOptimizer::VisitBranch(ir::Instruction *branchInst)
+{
+    auto *bb = branchInst->GetBasicBlock();
+    if (branchInst->GetOpcode() == ir::Opcode::BRANCH) {
+        MarkEdgeExecutable(bb, 0);
+        return;
+    }
+    const auto &condition = GetValue(branchInst->GetFirstOp());
+    switch (condition.state) {
+        case LatticeValue::State::UNDEFINED:
+            break;
+        case LatticeValue::State::CONSTANT:
+            MarkEdgeExecutable(bb, condition.value != 0 ? 0 : 1);
+            break;
+        case LatticeValue::State::OVERDEFINED:
+            MarkEdgeExecutable(bb, 0);
+            MarkEdgeExecutable(bb, 1);
+            break;
+        default:
+            UNREACHABLE();
+    }
+}
+
+SCCPOptimizer::LatticeValue SCCPOptimizer::Evaluate(ir::Instruction *inst) const
+{
+    switch (inst->GetOpcode()) {
+        case ir::Opcode::CONSTANT:
+            return {LatticeValue::State::CONSTANT, inst->As<ir::AssignInst>()->GetValue()};
+        case ir::Opcode::ADD:
+        case ir::Opcode::MUL:
+        case ir::Opcode::SHL:
+        case ir::Opcode::XOR:
+        case ir::Opcode::COMPARE:
+            return EvaluateBinary(inst);
+        case ir::Opcode::PHI:
+            return EvaluatePhi(inst);
+        default:
+            // parameters, memory accesses and calls are unknown
+            return {LatticeValue::State::OVERDEFINED, 0};
+    }
+}
+
+SCCPOptimizer::LatticeValue SCCPOptimizer::EvaluatePhi(ir::Instruction *phiInst) const
+{
+    auto *phi = phiInst->As<ir::PhiInst>();
+    auto *bb = phi->GetBasicBlock();
+    auto result = LatticeValue {};
+    for (size_t idx = 0; idx < phi->GetInputs().Size(); ++idx) {
+        if (IsEdgeExecutable(phi->GetIncomingBlock(idx), bb)) {
+            result = LatticeValue::Meet(result, GetValue(phi->GetInput(idx)));
+        }
+    }
+    return result;
+}
+
+SCCPOptimizer::LatticeValue SCCPOptimizer::EvaluateBinary(ir::Instruction *inst) const
+{
+    const auto &lhs = GetValue(inst->GetFirstOp());
+    const auto &rhs = GetValue(inst->GetLastOp());
+    if (lhs.state == LatticeValue::State::OVERDEFINED || rhs.state == LatticeValue::State::OVERDEFINED) {
+        return {LatticeValue::State::OVERDEFINED, 0};
+    }
+    if (lhs.state == LatticeValue::State::UNDEFINED || rhs.state == LatticeValue::State::UNDEFINED) {
+        return {};
+    }
+    auto c1 = lhs.value;
+    auto c2 = rhs.value;
+    // values wrap around to the width of the instruction before compares and branches see them
+    auto resType = inst->GetResultType();
+    switch (inst->GetOpcode()) {
+        case ir::Opcode::ADD:
+            return {LatticeValue::State::CONSTANT, ir::WrapToResultType(resType, WrapAdd(c1, c2))};
+        case ir::Opcode::MUL:
+            return {LatticeValue::State::CONSTANT, ir::WrapToResultType(resType, WrapMul(c1, c2))};
+        case ir::Opcode::XOR:
+            return {LatticeValue::State::CONSTANT, ir::WrapToResultType(resType, c1 ^ c2)};
+        case ir::Opcode::SHL: {
+            // shifts by the type width or more are not folded by peepholes as well
+            auto bits = static_cast<int64_t>(ir::GetResultTypeBits(resType));
+            if (c2 < 0 || c2 >= bits) {
+                return {LatticeValue::State::OVERDEFINED, 0};
+            }
+            auto value = static_cast<int64_t>(static_cast<uint64_t>(c1) << c2);
+            return {LatticeValue::State::CONSTANT, ir::WrapToResultType(resType, value)};
+        }
+        case ir::Opcode::COMPARE: {
+            auto isUnsigned =
+                ir::IsUnsignedResultType(ir::CombineResultType(inst->GetFirstOp(), inst->GetLastOp()));
+            auto isLess = isUnsigned ? static_cast<uint64_t>(c1) < static_cast<uint64_t>(c2) : c1 < c2;
+            auto isEqual = c1 == c2;
+            auto flags = inst->As<ir::LogicInst>()->GetCmpFlags();
+            auto result = flags == ir::CmpFlags::LT ? isLess : (isLess || isEqual);
+            return {LatticeValue::State::CONSTANT, result ? 1 : 0};
+        }
+        default:
+            UNREACHABLE();
+    }
+}
+
+const SCCPOptimizer::LatticeValue &SCCPOptimizer::GetValue(ir::Instruction *inst) const
+{
+    return values_[inst->GetInstId().GetId()];
+}
+
+/* static */
+SCCPOptimizer::LatticeValue SCCPOptimizer::LatticeValue::Meet(const LatticeValue &lhs, const LatticeValue &rhs)
+{
+    if (lhs.state == State::UNDEFINED) {
+        return rhs;
+    }
+    if (rhs.state == State::UNDEFINED || lhs == rhs) {
+        return lhs;
+    }
+    return {State::OVERDEFINED, 0};
+}
+
+size_t SCCPOptimizer::FoldConstants()
+{
+    size_t foldedCount = 0;
+    // constants created here are not numbered
+    auto instIdsBound = values_.size();
+    graph_->IterateOverBlocks([this, instIdsBound, &foldedCount](ir::BasicBlock *bb) {
+        if (!IsExecutable(bb)) {
+            return;
+        }
+        bb->IterateOverInstructions([this, instIdsBound, &foldedCount](ir::Instruction *inst) {
+            auto id = inst->GetInstId().GetId();
+            if (id >= instIdsBound || inst->GetOpcode() == ir::Opcode::CONSTANT ||
+                values_[id].state != LatticeValue::State::CONSTANT) {
+                return false;
+            }
+            auto *constInst = CreateConstInst(graph_, inst->GetResultType(), values_[id].value);
+            ir::Instruction::UpdateUsersAndEliminate(inst, constInst);
+            ++foldedCount;
+            return false;
+        });
+    });
+    return foldedCount;
+}
+
+size_t SCCPOptimizer::FoldBranches()
+{
+    std::vector<ir::Instruction *> branches;
+    graph_->IterateOverBlocks([this, &branches](ir::BasicBlock *bb) {
+        auto *lastInst = bb->GetLastInstruction();
+        if (IsExecutable(bb) && lastInst != nullptr && lastInst->GetOpcode() == ir::Opcode::COND_BRANCH &&
+            lastInst->GetFirstOp()->GetOpcode() == ir::Opcode::CONSTANT) {
+            branches.push_back(lastInst);
+        }
+    });
+    for (auto *branchInst : branches) {
+        auto *bb = branchInst->GetBasicBlock();
+        auto isTaken = branchInst->GetFirstOp()->As<ir::AssignInst>()->GetValue() != 0;
+        bb->RemoveSuccessor(isTaken ? 1 : 0);
+        auto *newBranch = graph_->GetAllocator()->New<ir::BranchInst>(bb, ir::InstId {graph_->NewInstId()},
+                                                                     ir::Opcode::BRANCH, ir::InstProxyList {});
+        newBranch->InsertInstBefore(branchInst);
+        ir::Instruction::Eliminate(branchInst);
+    }
+    return branches.size();
+}
+
+size_t SCCPOptimizer::RemoveNotExecutedBlocks()
+{
+    std::vector<ir::BasicBlock *> notExecutedBlocks;
+    graph_->IterateOverBlocks([this, &notExecutedBlocks](ir::BasicBlock *bb) {
+        if (!IsExecutable(bb)) {
+            notExecutedBlocks.push_back(bb);
+        }
+    });
+    // not executed blocks are reachable only through removed edges and other not executed blocks
+    graph_->RemoveBasicBlocks(notExecutedBlocks);
+    return notExecutedBlocks.size();
+}
+
+bool LICMOptimizer::Run()
+{
+    PassScope passScope {graph_, "LICMOptimizer"};
+    auto createdCount = CreatePreHeaders();
+    if (createdCount != 0) {
+        // loops are recomputed together with the new blocks
+        analysisManager_->Invalidate();
+    }
+    auto hoistedCount = HoistInvariants();
+    CountStatistic(graph_, StatCounter::HOISTED_INSTS, hoistedCount);
+    return createdCount != 0 || hoistedCount != 0;
+}
+
+/* static */
+bool LICMOptimizer::IsHoistable(ir::Instruction *inst)
+{
+    switch (inst->GetOpcode()) {
+        case ir::Opcode::ADD:
+        case ir::Opcode::MUL:
+        case ir::Opcode::SHL:
+        case ir::Opcode::XOR:
+        case ir::Opcode::COMPARE:
+        case ir::Opcode::LOAD:
+        case ir::Opcode::CHECK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* static */
+bool LICMOptimizer::MayAlias(ir::Instruction *mem1, ir::Instruction *mem2)
+{
+    return mem1 == mem2 || mem1->GetOpcode() != ir::Opcode::MEM || mem2->GetOpcode() != ir::Opcode::MEM;
+}
+
+size_t LICMOptimizer::CreatePreHeaders()
+{
+    auto &loopAnalysis = analysisManager_->GetAnalysis<LoopAnalysis>();
+    if (loopAnalysis.GetLoops().empty()) {
+        return 0;
+    }
+    domTree_ = &analysisManager_->GetAnalysis<DominatorsTree>();
+    CollectMemoryInfo(loopAnalysis);
+
+    // indexed by loop id
+    std::vector<bool> needsPreHeader(memoryInfos_.size(), false);
+    for (auto *bb : analysisManager_->GetAnalysis<RPO>().GetRpoVector()) {
+        bb->IterateOverInstructions([this, &loopAnalysis, &needsPreHeader](ir::Instruction *inst) {
+            auto *loop = FindHoistLoop(inst, loopAnalysis, false);
+            if (loop != nullptr && loop->GetPreHeader() == nullptr) {
+                needsPreHeader[loop->GetId()] = true;
+            }
+            return false;
+        });
+    }
+
+    size_t createdCount = 0;
+    for (auto *loop : loopAnalysis.GetLoops()) {
+        if (needsPreHeader[loop->GetId()]) {
+            CreatePreHeader(loop, loopAnalysis);
+            ++createdCount;
+        }
+    }
+    return createdCount;
+}
+
+/* static */
+ir::BasicBlock *LICMOptimizer::CreatePreHeader(Loop *loop, const LoopAnalysis &loopAnalysis)
+{
+    auto *header = loop->GetHeader();
+    std::vector<ir::BasicBlock *> outsidePreds;
+    for (auto *pred : header->GetPredecessors()) {
+        if (!loop->Contains(loopAnalysis.GetLoop(pred))) {
+            outsidePreds.push_back(pred);
+        }
+    }
+    auto isOutsidePred = [&outsidePreds](ir::BasicBlock *bb) {
+        return std::find(outsidePreds.begin(), outsidePreds.end(), bb) != outsidePreds.end();
+    };
+
+    auto *preHeader = ir::BasicBlock::Create(header->GetGraph());
+    // values coming from outside of the loop are merged in the pre-header
+    header->IterateOverInstructions([preHeader, &isOutsidePred](ir::Instruction *inst) {
+        // phis are placed at the beginning of the block
+        if (inst->GetOpcode() != ir::Opcode::PHI) {
+            return true;
+        }
+        auto *phi = inst->As<ir::PhiInst>();
+        std::vector<std::pair<ir::Instruction *, ir::BasicBlock *>> outsideInputs;
+        for (auto idx = phi->GetInputs().Size(); idx > 0; --idx) {
+            auto *incomingBlock = phi->GetIncomingBlock(idx - 1);
+            if (isOutsidePred(incomingBlock)) {
+                outsideInputs.emplace_back(phi->GetInput(idx - 1), incomingBlock);
+                phi->RemoveDependency(idx - 1);
+            }
+        }
+        if (outsideInputs.empty()) {
+            return false;
+        }
+        auto *value = outsideInputs.front().first;
+        if (std::any_of(outsideInputs.begin(), outsideInputs.end(),
+                        [value](const auto &outsideInput) { return outsideInput.first != value; })) {
+            auto *preHeaderPhi = CreatePhi(preHeader, phi->GetResultType())->As<ir::PhiInst>();
+            for (auto [input, incomingBlock] : outsideInputs) {
+                preHeaderPhi->ResolveDependency(input, incomingBlock);
+            }
+            value = preHeaderPhi;
+        }
+        phi->ResolveDependency(value, preHeader);
+        return false;
+    });
+
+    for (auto *pred : outsidePreds) {
+        pred->ReplaceSuccessor(header, preHeader);
+    }
+    preHeader->SetTrueSuccessor(header);
+    CreateBr(preHeader);
+    return preHeader;
+}
+
+size_t LICMOptimizer::HoistInvariants()
+{
+    auto &loopAnalysis = analysisManager_->GetAnalysis<LoopAnalysis>();
+    if (loopAnalysis.GetLoops().empty()) {
+        return 0;
+    }
+    domTree_ = &analysisManager_->GetAnalysis<DominatorsTree>();
+    CollectMemoryInfo(loopAnalysis);
+
+    // inputs are visited before their users except phis which are never hoisted, so chains of invariants are moved
+    // in a single sweep
+    size_t hoistedCount = 0;
+    for (auto *bb : analysisManager_->GetAnalysis<RPO>().GetRpoVector()) {
+        bb->IterateOverInstructions([this, &loopAnalysis, &hoistedCount](ir::Instruction *inst) {
+            auto *loop = FindHoistLoop(inst, loopAnalysis, true);
+            if (loop != nullptr) {
+                auto *preHeaderEnd = loop->GetPreHeader()->GetLastInstruction();
+                ASSERT(preHeaderEnd != nullptr && preHeaderEnd->GetOpcode() == ir::Opcode::BRANCH);
+                inst->MoveBefore(preHeaderEnd);
+                ++hoistedCount;
+            }
+            return false;
+        });
+    }
+    return hoistedCount;
+}
+
+void LICMOptimizer::CollectMemoryInfo(const LoopAnalysis &loopAnalysis)
+{
+    auto &loops = loopAnalysis.GetLoops();
+    memoryInfos_.assign(loops.size() + 1, {});
+    // inner loops go after outer ones, their effects are merged into outer loops
+    for (auto loopIt = loops.rbegin(); loopIt != loops.rend(); ++loopIt) {
+        auto *loop = *loopIt;
+        auto &memoryInfo = memoryInfos_[loop->GetId()];
+        for (auto *bb : loop->GetBlocks()) {
+            bb->IterateOverInstructions([&memoryInfo](ir::Instruction *inst) {
+                auto opcode = inst->GetOpcode();
+                if (opcode == ir::Opcode::CALL_STATIC) {
+                    memoryInfo.hasCalls = true;
+                } else if (opcode == ir::Opcode::STORE || opcode == ir::Opcode::CHECK) {
+                    memoryInfo.clobberedMems.push_back(inst->GetInput(0));
+                }
+                return false;
+            });
+        }
+        auto *outerLoop = loop->GetOuterLoop();
+        if (!outerLoop->IsRoot()) {
+            auto &outerInfo = memoryInfos_[outerLoop->GetId()];
+            outerInfo.hasCalls |= memoryInfo.hasCalls;
+            outerInfo.clobberedMems.insert(outerInfo.clobberedMems.end(), memoryInfo.clobberedMems.begin(),
+                                           memoryInfo.clobberedMems.end());
+        }
+    }
+}
+
+Loop *LICMOptimizer::FindHoistLoop(ir::Instruction *inst, const LoopAnalysis &loopAnalysis, bool needsPreHeader) const
+{
+    if (!IsHoistable(inst)) {
+        return nullptr;
+    }
+    Loop *hoistLoop = nullptr;
+    for (auto *loop = loopAnalysis.GetLoop(inst->GetBasicBlock()); !loop->IsRoot() && !loop->IsIrreducible();
+         loop = loop->GetOuterLoop()) {
+        if (!IsInvariant(inst, loop, loopAnalysis)) {
+            break;
+        }
+        if (!needsPreHeader || loop->GetPreHeader() != nullptr) {
+            hoistLoop = loop;
+        }
+    }
+    return hoistLoop;
+}
+
+bool LICMOptimizer::IsInvariant(ir::Instruction *inst, Loop *loop, const LoopAnalysis &loopAnalysis) const
+{
+    for (auto *input : inst->GetInputs()) {
+        if (loop->Contains(loopAnalysis.GetLoop(input->GetBasicBlock()))) {
+            return false;
+        }
+    }
+    auto opcode = inst->GetOpcode();
+    if (opcode == ir::Opcode::CHECK) {
+        // check which may fail on some iterations only or after side effects of an iteration is kept in the loop
+        return IsFirstSideEffect(inst, loop);
+    }
+    if (opcode != ir::Opcode::LOAD) {
+        return true;
+    }
+    auto &memoryInfo = memoryInfos_[loop->GetId()];
+    auto *mem = inst->GetInput(0);
+    if (memoryInfo.hasCalls || std::any_of(memoryInfo.clobberedMems.begin(), memoryInfo.clobberedMems.end(),
+                                           [mem](ir::Instruction *clobbered) { return MayAlias(mem, clobbered); })) {
+        return false;
+    }
+    // load is not speculated, it may read out of bounds on iterations which do not execute it
+    return IsExecutedOnEveryIteration(inst->GetBasicBlock(), loop, loopAnalysis);
+}
+
+/* static */
+bool LICMOptimizer::IsFirstSideEffect(ir::Instruction *inst, Loop *loop)
+{
+    auto *header = loop->GetHeader();
+    if (inst->GetBasicBlock() != header) {
+        return false;
+    }
+    // checks hoisted earlier in the same sweep are already moved out of the header
+    auto isFirst = false;
+    header->IterateOverInstructions([inst, &isFirst](ir::Instruction *headerInst) {
+        if (headerInst == inst) {
+            isFirst = true;
+            return true;
+        }
+        auto opcode = headerInst->GetOpcode();
+        return opcode == ir::Opcode::STORE || opcode == ir::Opcode::CALL_STATIC || opcode == ir::Opcode::CHECK;
+    });
+    return isFirst;
+}
+
+bool LICMOptimizer::IsExecutedOnEveryIteration(ir::BasicBlock *bb, Loop *loop, const LoopAnalysis &loopAnalysis) const
+{
+    for (auto *latch : loop->GetBackEdges()) {
+        if (!domTree_->DoesBlockDominatesOn(latch, bb)) {
+            return false;
+        }
+    }
+    for (auto *exitBlock : loop->GetExitBlocks()) {
+        for (auto *pred : exitBlock->GetPredecessors()) {
+            if (loop->Contains(loopAnalysis.GetLoop(pred)) && !domTree_->DoesBlockDominatesOn(pred, bb)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool StrengthReductionOptimizer::Run()
+{
+    PassScope passScope {graph_, "StrengthReductionOptimizer"};
+    if (analysisManager_->GetAnalysis<LoopAnalysis>().GetLoops().empty()) {
+        return false;
+    }
+    InductionAnalysis inductionAnalysis {graph_, analysisManager_.Get()};
+    inductionAnalysis.Run();
+    auto mergedCount = MergeRedundantVariables(inductionAnalysis);
+    if (mergedCount != 0) {
+        // users of merged variables are derived from the remaining ones now
+        inductionAnalysis.Run();
+    }
+    auto reducedCount = ReduceVariables(inductionAnalysis);
+    CountStatistic(graph_, StatCounter::REDUNDANT_INSTS, mergedCount);
+    CountStatistic(graph_, StatCounter::REDUCED_INDUCTIONS, reducedCount);
+    return mergedCount != 0 || reducedCount != 0;
+}
+
+size_t StrengthReductionOptimizer::MergeRedundantVariables(const InductionAnalysis &inductionAnalysis)
+{
+    auto isSameStart = [](ir::Instruction *start1, ir::Instruction *start2) {
+        int64_t value1 = 0;
+        int64_t value2 = 0;
+        return start1 == start2 || (start1->GetResultType() == start2->GetResultType() &&
+                                    pattern::AnyConst(&value1).Match(start1) &&
+                                    pattern::AnyConst(&value2).Match(start2) && value1 == value2);
+    };
+    size_t eliminatedCount = 0;
+    for (auto *loop : analysisManager_->GetAnalysis<LoopAnalysis>().GetLoops()) {
+        // basic variables go first
+        std::vector<const InductionVariable *> keptVars;
+        for (const auto *var : inductionAnalysis.GetInductionVariables(loop)) {
+            if (!var->IsBasic()) {
+                break;
+            }
+            auto keptIt = std::find_if(keptVars.begin(), keptVars.end(), [var, &isSameStart](const auto *keptVar) {
+                return keptVar->inst->GetResultType() == var->inst->GetResultType() && keptVar->step == var->step &&
+                       isSameStart(keptVar->start, var->start);
+            });
+            if (keptIt == keptVars.end()) {
+                keptVars.push_back(var);
+                continue;
+            }
+            // the increment of the duplicate is computed from the kept phi then, it is left to GVN if it is used
+            ir::Instruction::UpdateUsersAndEliminate(var->inst, (*keptIt)->inst);
+            ++eliminatedCount;
+            if (!var->next->HasUsers()) {
+                ir::Instruction::Eliminate(var->next);
+                ++eliminatedCount;
+            }
+        }
+    }
+    return eliminatedCount;
+}
+
+size_t StrengthReductionOptimizer::ReduceVariables(const InductionAnalysis &inductionAnalysis)
+{
+    std::vector<const InductionVariable *> reducibleVars;
+    for (auto *loop : analysisManager_->GetAnalysis<LoopAnalysis>().GetLoops()) {
+        if (loop->GetPreHeader() == nullptr) {
+            continue;
+        }
+        for (const auto *var : inductionAnalysis.GetInductionVariables(loop)) {
+            if (IsReducible(*var, inductionAnalysis)) {
+                reducibleVars.push_back(var);
+            }
+        }
+    }
+    // variables derived from the reduced one are reduced before it, so its computation is alive until it is reduced
+    for (auto varIt = reducibleVars.rbegin(); varIt != reducibleVars.rend(); ++varIt) {
+        Reduce(**varIt);
+    }
+    return reducibleVars.size();
+}
+
+/* static */
+bool StrengthReductionOptimizer::IsReducible(const InductionVariable &var, const InductionAnalysis &inductionAnalysis)
+{
+    // the step is a constant of the variable type
+    auto resType = var.inst->GetResultType();
+    if (var.IsBasic() || !ValueRange {var.step, var.step}.IsInside(ValueRange::OfType(resType))) {
+        return false;
+    }
+    bool hasMultiplication = false;
+    for (const auto *derivedVar = &var; !derivedVar->IsBasic(); derivedVar = derivedVar->parent) {
+        auto opcode = derivedVar->inst->GetOpcode();
+        hasMultiplication |= opcode == ir::Opcode::MUL || opcode == ir::Opcode::SHL;
+    }
+    if (!hasMultiplication) {
+        return false;
+    }
+    // the variable is recomputed together with the derived ones otherwise
+    for (auto *user : var.inst->GetUsers()) {
+        const auto *userVar = inductionAnalysis.GetInductionVariable(user);
+        if (userVar == nullptr || userVar->parent != &var) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void StrengthReductionOptimizer::Reduce(const InductionVariable &var)
+{
+    std::vector<const InductionVariable *> chain;
+    for (const auto *derivedVar = &var; !derivedVar->IsBasic(); derivedVar = derivedVar->parent) {
+        chain.push_back(derivedVar);
+    }
+
+    // the initial value is the chain computed from the start of the basic variable
+    auto *loop = var.loop;
+    auto *preHeaderEnd = loop->GetPreHeader()->GetLastInstruction();
+    ASSERT(preHeaderEnd != nullptr && preHeaderEnd->GetOpcode() == ir::Opcode::BRANCH);
+    const auto *basicVar = chain.back()->parent;
+    auto *value = basicVar->start;
+    auto *parentInst = basicVar->inst;
+    for (auto chainIt = chain.rbegin(); chainIt != chain.rend(); ++chainIt) {
+        auto *inst = (*chainIt)->inst;
+        auto *op1 = inst->GetFirstOp() == parentInst ? value : inst->GetFirstOp();
+        auto *op2 = inst->GetLastOp() == parentInst ? value : inst->GetLastOp();
+        value = CreateArithmInst(preHeaderEnd, inst->GetResultType(), inst->GetOpcode(), op1, op2);
+        parentInst = inst;
+    }
+
+    auto resType = var.inst->GetResultType();
+    auto *header = loop->GetHeader();
+    auto *latch = loop->GetBackEdges().front();
+    auto *phi = CreatePhi(header, resType)->As<ir::PhiInst>();
+    auto *stepInst = CreateConstInst(graph_, resType, var.step);
+    auto *nextInst = CreateArithmInst(latch->GetLastInstruction(), resType, ir::Opcode::ADD, phi, stepInst);
+    phi->ResolveDependency(value, loop->GetPreHeader());
+    phi->ResolveDependency(nextInst, latch);
+
+    var.inst->ReplaceUsersWith(phi);
+    for (auto *deadVar : chain) {
+        if (deadVar->inst->HasUsers()) {
+            break;
+        }
+        ir::Instruction::Eliminate(deadVar->inst);
+    }
+}
+
 }  // namespace compiler
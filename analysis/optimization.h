@@ -1,10 +1,13 @@
 #ifndef ANALYSIS_OPTIMIZATION_H
 #define ANALYSIS_OPTIMIZATION_H
 
+#include "analysis/pass_manager.h"
 #include "ir/common.h"
 
 #include <array>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace compiler {
 
@@ -16,45 +19,89 @@ class ArithmInst;
 class CallStaticInst;
 }  // namespace ir
 
+class InductionAnalysis;
+struct InductionVariable;
+
 class PeepHoleOptimizer {
 public:
-    explicit PeepHoleOptimizer(ir::Graph *graph) : graph_(graph) {}
+    // instructions are replaced inside blocks, control flow is kept
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit PeepHoleOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
 
-    void Run();
+    /// @return true if the graph was changed
+    bool Run();
 
 private:
-    enum class OptStatus { NO_OPT, OPT, CANT_OPT };
+    static ir::Instruction *OptimizeStub([[maybe_unused]] ir::Instruction *inst)
+    {
+        return nullptr;
+    }
 
-    static void OptimizeStub([[maybe_unused]] ir::Instruction *inst) {}
-    static void OptimizeAdd(ir::Instruction *addInst);
-    static void OptimizeShl(ir::Instruction *shlInst);
-    static void OptimizeXor(ir::Instruction *xorInst);
-    static void OptimizePhi(ir::Instruction *phiInst);
+    // Optimizers return the instruction which replaces the optimized one, the instruction itself if it was changed
+    // in place or nullptr
+    static ir::Instruction *OptimizeAdd(ir::Instruction *addInst);
+    static ir::Instruction *OptimizeMul(ir::Instruction *mulInst);
+    static ir::Instruction *OptimizeShl(ir::Instruction *shlInst);
+    static ir::Instruction *OptimizeXor(ir::Instruction *xorInst);
+    static ir::Instruction *OptimizePhi(ir::Instruction *phiInst);
 
-    using BothConstOpt = int64_t (*)(int64_t op1, int64_t op2);
-    using FirstConstOpt = ir::Instruction *(*)(int64_t op1, ir::Instruction *inst);
-    using SecondConstOpt = ir::Instruction *(*)(ir::Instruction *inst, int64_t op2);
-    static OptStatus OptimizeConstArithm(ir::ArithmInst *inst, BothConstOpt bothConstOpt, FirstConstOpt firstConstOpt,
-                                         SecondConstOpt secondConstOpt);
+    // Helpers of the rules which count statistics
+    static ir::Instruction *Fold(ir::Instruction *inst, int64_t value);
+    static ir::Instruction *Simplify(ir::Instruction *inst, ir::Instruction *newInst);
+    static ir::Instruction *SimplifyToConst(ir::Instruction *inst, int64_t value);
+    // Replaces inputs of `(value op c1) op c2` with value and c1 op c2 given as constValue
+    static ir::Instruction *Reassociate(ir::Instruction *inst, ir::Instruction *value, int64_t constValue);
 
-    using SameInputsOpt = ir::Instruction *(*)(ir::Instruction *inst);
-    static OptStatus OptimizeSameInputs(ir::ArithmInst *inst, SameInputsOpt sameInputsOpt);
+    /// @return true if inputs were swapped
+    static bool CanonicalizeCommutative(ir::Instruction *inst);
+    // Replaces multiplication by constant with shifts and additions if it takes at most two shifts
+    static ir::Instruction *ReduceMulByConst(ir::Instruction *mulInst, ir::Instruction *value, int64_t constValue);
 
     static constexpr auto OptimizerCnt = static_cast<uint32_t>(ir::Opcode::COUNT);
-    using Optimizer = void (*)(ir::Instruction *inst);
+    using Optimizer = ir::Instruction *(*)(ir::Instruction *inst);
     using OptimizerMap = std::array<Optimizer, OptimizerCnt>;
 
     static OptimizerMap CreateOptimizers();
     static inline OptimizerMap OpcodeToOptimizer = CreateOptimizers();
 
+    // Replaces the instruction if its optimizer succeeds and pushes users which need to be revisited
+    void Optimize(ir::Instruction *inst, bool isSweep);
+
+    void PushUsersToWorklist(ir::Instruction *inst, bool isSweep);
+    // Does nothing if the instruction has no optimizer or it is already in the worklist
+    void PushToWorklist(ir::Instruction *inst);
+
+    bool IsInWorklist(ir::Instruction *inst) const;
+
     ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
+    // instructions whose inputs were replaced after they had been visited
+    std::vector<ir::Instruction *> worklist_;
+    // indexed by instruction id, empty until the first push
+    std::vector<bool> inWorklist_;
+    bool isChanged_ {false};
 };
 
+// Removes checks dominated by equal or stronger ones, bound checks of induction variables which are compared with the
+// length of the memory before every access and bound checks whose indices are proven to be in range by RangeAnalysis.
+// Invariant checks are moved out of loops by LICMOptimizer
 class CheckOptimizer {
 public:
-    explicit CheckOptimizer(ir::Graph *graph) : graph_(graph) {}
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit CheckOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
 
-    void Run();
+    /// @return true if the graph was changed
+    bool Run();
 
 private:
     static bool OptimizePredStub([[maybe_unused]] ir::Instruction *inst1, [[maybe_unused]] ir::Instruction *inst2)
@@ -66,20 +113,42 @@ private:
     static bool OptimizePredBounds(ir::Instruction *boundsInst1, ir::Instruction *boundsInst2);
 
     static constexpr auto OptimizerCnt = static_cast<uint32_t>(ir::CheckType::COUNT);
+    // Does the passed dominating check inst1 make the dominated check inst2 redundant?
     using OptimizerPredicate = bool (*)(ir::Instruction *inst1, ir::Instruction *inst2);
     using PredicatesMap = std::array<OptimizerPredicate, OptimizerCnt>;
 
     static PredicatesMap CreateOptimizerPredicates();
     static inline PredicatesMap TypeToOptimizerPredicate = CreateOptimizerPredicates();
 
+    /// @return number of eliminated checks
+    size_t EliminateLoopBoundChecks();
+
+    /**
+     * Index phi of the loop header is proven to be in [0, length) if it starts from a non-negative constant,
+     * is incremented by one and `phi < length` is checked on every iteration before the access
+     */
+    static bool IsIndexInBounds(ir::Instruction *checkInst, ir::Instruction *phiInst, Loop *loop,
+                                const DominatorsTree &domTree);
+
+    /// @return number of eliminated bound checks of memory with constant count whose indices are in [0, count)
+    size_t EliminateInRangeBoundChecks(const std::vector<ir::Instruction *> &knownCountMems);
+
     ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
 };
 
 class InliningOptimizer {
 public:
-    explicit InliningOptimizer(ir::Graph *graph) : graph_(graph) {}
+    static constexpr AnalysisMask PreservedAnalyses = NoAnalyses;
 
-    void Run();
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit InliningOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
+
+    /// @return true if the graph was changed
+    bool Run();
 
 private:
     template <typename T>
@@ -97,6 +166,260 @@ private:
     static void MergeDataFLow(ir::CallStaticInst *callInst, ir::BasicBlock *firstCalleeBB, ir::BasicBlock *postCallBB);
 
     ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
+};
+
+// Replaces pure instructions by equal ones which dominate them. Values are numbered in preorder of the dominator tree,
+// a value is visible in the subtree of its block only
+class GVNOptimizer {
+public:
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit GVNOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
+
+    /// @return true if the graph was changed
+    bool Run();
+
+private:
+    // Equal keys are built for instructions computing the same value
+    struct ValueKey {
+        ir::Opcode opcode {ir::Opcode::INVALID};
+        ir::ResultType resType {ir::ResultType::INVALID};
+        ir::CmpFlags cmpFlags {ir::CmpFlags::INVALID};
+        int64_t constValue {0};
+        ir::Instruction *op1 {nullptr};
+        ir::Instruction *op2 {nullptr};
+
+        bool operator==(const ValueKey &other) const;
+    };
+
+    struct ValueKeyHash {
+        size_t operator()(const ValueKey &key) const;
+    };
+
+    // Instructions without side effects whose result depends on inputs only
+    static bool IsNumbered(ir::Instruction *inst);
+
+    static ValueKey MakeKey(ir::Instruction *inst);
+
+    /// @return true if the instruction was replaced
+    bool NumberValue(ir::Instruction *inst);
+
+    ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
+    using ValuesMap = std::unordered_map<ValueKey, ir::Instruction *, ValueKeyHash>;
+
+    ValuesMap values_;
+    // values which are visible in the current block in order of numbering
+    std::vector<ValuesMap::iterator> scopeValues_;
+};
+
+// Removes unreachable blocks and instructions without side effects whose values are not used by live instructions
+class DCEOptimizer {
+public:
+    // Pass invalidates analyses by itself if it removes blocks
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit DCEOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
+
+    /// @return true if the graph was changed
+    bool Run();
+
+private:
+    /// @return number of removed blocks
+    size_t RemoveUnreachableBlocks();
+
+    /// @return number of removed instructions
+    size_t RemoveDeadInstructions();
+
+    // Instructions which are kept even without users
+    static bool HasSideEffects(ir::Instruction *inst);
+
+    void MarkLive(ir::Instruction *inst);
+
+    ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
+    // indexed by instruction id
+    std::vector<bool> isLive_;
+    std::vector<ir::Instruction *> worklist_;
+};
+
+/**
+ * Sparse conditional constant propagation. Values of instructions and executable edges are computed together,
+ * so phis ignore values coming by edges which are never taken. Then instructions with constant values are replaced
+ * by constants, branches with constant conditions become unconditional and blocks which are never executed are removed
+ */
+class SCCPOptimizer {
+public:
+    // Pass invalidates analyses by itself if it changes control flow
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit SCCPOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
+
+    /// @return true if the graph was changed
+    bool Run();
+
+private:
+    struct LatticeValue {
+        // values only go down: undefined, then constant, then overdefined
+        enum class State : uint8_t { UNDEFINED, CONSTANT, OVERDEFINED };
+
+        State state {State::UNDEFINED};
+        int64_t value {0};
+
+        bool operator==(const LatticeValue &other) const
+        {
+            return state == other.state && (state != State::CONSTANT || value == other.value);
+        }
+
+        bool operator!=(const LatticeValue &other) const
+        {
+            return !(*this == other);
+        }
+
+        static LatticeValue Meet(const LatticeValue &lhs, const LatticeValue &rhs);
+    };
+
+    void Propagate();
+    void MarkEdgeExecutable(ir::BasicBlock *bb, size_t succIdx);
+    bool IsEdgeExecutable(ir::BasicBlock *pred, ir::BasicBlock *succ) const;
+    bool IsExecutable(ir::BasicBlock *bb) const;
+
+    void VisitInstruction(ir::Instruction *inst);
+    void VisitBranch(ir::Instruction *branchInst);
+    LatticeValue Evaluate(ir::Instruction *inst) const;
+    LatticeValue EvaluatePhi(ir::Instruction *phiInst) const;
+    LatticeValue EvaluateBinary(ir::Instruction *inst) const;
+    const LatticeValue &GetValue(ir::Instruction *inst) const;
+
+    /// @return number of replaced instructions
+    size_t FoldConstants();
+    /// @return number of folded branches
+    size_t FoldBranches();
+    /// @return number of removed blocks
+    size_t RemoveNotExecutedBlocks();
+
+    ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
+    // indexed by instruction id
+    std::vector<LatticeValue> values_;
+    // indexed by block id
+    std::vector<bool> isExecutable_;
+    // bit per successor index, indexed by block id
+    std::vector<uint8_t> executableEdges_;
+    // blocks whose instructions are visited for the first time
+    std::vector<ir::BasicBlock *> blockWorklist_;
+    std::vector<ir::Instruction *> instWorklist_;
+};
+
+/**
+ * Loop invariant code motion. Pure instructions whose inputs are defined outside of a loop are moved to its
+ * pre-header, loads are moved only if the memory is not written or checked in the loop and the load is executed
+ * on every iteration. Invariant checks of the header which precede its stores, calls and other checks become
+ * a single guard in the pre-header.
+ * Pre-headers are created for loops which have invariant instructions only
+ */
+class LICMOptimizer {
+public:
+    // Pass invalidates analyses by itself if it creates pre-headers
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit LICMOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
+
+    /// @return true if the graph was changed
+    bool Run();
+
+private:
+    // Memory effects of a loop together with its inner loops
+    struct LoopMemoryInfo {
+        bool hasCalls {false};
+        // memory written by stores or guarded by checks
+        std::vector<ir::Instruction *> clobberedMems;
+    };
+
+    static bool IsHoistable(ir::Instruction *inst);
+
+    // Memory of different allocations is distinct, any other memory value may alias
+    static bool MayAlias(ir::Instruction *mem1, ir::Instruction *mem2);
+
+    /// @return number of created pre-headers
+    size_t CreatePreHeaders();
+
+    static ir::BasicBlock *CreatePreHeader(Loop *loop, const LoopAnalysis &loopAnalysis);
+
+    /// @return number of hoisted instructions
+    size_t HoistInvariants();
+
+    void CollectMemoryInfo(const LoopAnalysis &loopAnalysis);
+
+    // Outermost loop the instruction may be moved out of, nullptr if it is not invariant in its own loop
+    Loop *FindHoistLoop(ir::Instruction *inst, const LoopAnalysis &loopAnalysis, bool needsPreHeader) const;
+
+    bool IsInvariant(ir::Instruction *inst, Loop *loop, const LoopAnalysis &loopAnalysis) const;
+
+    // Instruction is in the header of the loop and no store, call or check is executed before it on an iteration
+    static bool IsFirstSideEffect(ir::Instruction *inst, Loop *loop);
+
+    // Block is executed on every iteration which goes back to the header or leaves the loop
+    bool IsExecutedOnEveryIteration(ir::BasicBlock *bb, Loop *loop, const LoopAnalysis &loopAnalysis) const;
+
+    ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
+    const DominatorsTree *domTree_ {nullptr};
+    // indexed by loop id
+    std::vector<LoopMemoryInfo> memoryInfos_;
+};
+
+/**
+ * Loop strength reduction. Basic induction variables of a loop with the same start and step are merged into one.
+ * Derived induction variables computed by MUL or SHL, like `i * stride` and `base + (i << k)`, become phis of the
+ * header which are incremented by their step on the back edge, their initial values are computed in the pre-header
+ */
+class StrengthReductionOptimizer {
+public:
+    // new phis and increments are placed into existing blocks
+    static constexpr AnalysisMask PreservedAnalyses = AllAnalyses;
+
+    // Pass computes analyses by itself if analysisManager is nullptr
+    explicit StrengthReductionOptimizer(ir::Graph *graph, AnalysisManager *analysisManager = nullptr)
+        : graph_(graph), analysisManager_(graph, analysisManager)
+    {
+    }
+
+    /// @return true if the graph was changed
+    bool Run();
+
+private:
+    /// @return number of eliminated instructions
+    size_t MergeRedundantVariables(const InductionAnalysis &inductionAnalysis);
+
+    /// @return number of reduced variables
+    size_t ReduceVariables(const InductionAnalysis &inductionAnalysis);
+
+    // Variable is computed by a multiplication and its value is not only an input of derived variables
+    static bool IsReducible(const InductionVariable &var, const InductionAnalysis &inductionAnalysis);
+
+    // Replaces the variable by a phi of the header, its computation is eliminated if it becomes dead
+    void Reduce(const InductionVariable &var);
+
+    ir::Graph *graph_;
+    AnalysisManagerHolder analysisManager_;
 };
 
 }  // namespace compiler
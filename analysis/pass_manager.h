@@ -0,0 +1,136 @@
+#ifndef ANALYSIS_PASS_MANAGER_H
+#define ANALYSIS_PASS_MANAGER_H
+
+#include "analysis/analysis.h"
+#include "analysis/loop_analysis.h"
+#include "ir/graph.h"
+#include "utils/macros.h"
+
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace compiler {
+
+// Owns analyses of a graph and runs them on demand. Analysis stays valid until it is invalidated explicitly
+class AnalysisManager {
+public:
+    explicit AnalysisManager(ir::Graph *graph) : graph_(graph) {}
+    NO_COPY_SEMANTIC(AnalysisManager);
+    NO_MOVE_SEMANTIC(AnalysisManager);
+    ~AnalysisManager() = default;
+
+    // Runs the analysis if it is not valid
+    template <typename Analysis>
+    Analysis &GetAnalysis()
+    {
+        auto &entry = std::get<Entry<Analysis>>(entries_);
+        if (!IsValid<Analysis>()) {
+            if (!entry.analysis.has_value()) {
+                // analyses built on top of other ones take them from the manager
+                if constexpr (std::is_constructible_v<Analysis, ir::Graph *, AnalysisManager *>) {
+                    entry.analysis.emplace(graph_, this);
+                } else {
+                    entry.analysis.emplace(graph_);
+                }
+            }
+            entry.analysis->Run();
+            entry.cfgVersion = graph_->GetCfgVersion();
+            validAnalyses_ |= MakeAnalysisMask<Analysis::Type>();
+        }
+        // control flow was changed by a pass which declared the analysis preserved
+        ASSERT(entry.cfgVersion == graph_->GetCfgVersion());
+        return *entry.analysis;
+    }
+
+    template <typename Analysis>
+    bool IsValid() const
+    {
+        return (validAnalyses_ & MakeAnalysisMask<Analysis::Type>()) != 0;
+    }
+
+    // Analyses which are not preserved are recomputed on the next request
+    void Invalidate(AnalysisMask preserved = NoAnalyses)
+    {
+        validAnalyses_ &= preserved;
+    }
+
+private:
+    template <typename Analysis>
+    struct Entry {
+        std::optional<Analysis> analysis;
+        // version of control flow which the analysis was computed for
+        uint64_t cfgVersion {0};
+    };
+
+    ir::Graph *graph_;
+    AnalysisMask validAnalyses_ {NoAnalyses};
+    std::tuple<Entry<DFS>, Entry<RPO>, Entry<DominatorsTree>, Entry<LoopAnalysis>> entries_;
+};
+
+// Gives a pass the analyses of a pass manager or private ones if the pass is run standalone
+class AnalysisManagerHolder {
+public:
+    AnalysisManagerHolder(ir::Graph *graph, AnalysisManager *analysisManager) : analysisManager_(analysisManager)
+    {
+        if (analysisManager_ == nullptr) {
+            analysisManager_ = &ownAnalysisManager_.emplace(graph);
+        }
+    }
+    NO_COPY_SEMANTIC(AnalysisManagerHolder);
+    NO_MOVE_SEMANTIC(AnalysisManagerHolder);
+    ~AnalysisManagerHolder() = default;
+
+    AnalysisManager *operator->() const
+    {
+        return analysisManager_;
+    }
+
+    AnalysisManager *Get() const
+    {
+        return analysisManager_;
+    }
+
+private:
+    AnalysisManager *analysisManager_;
+    std::optional<AnalysisManager> ownAnalysisManager_;
+};
+
+/**
+ * Runs passes over a graph sharing analyses between them. Every pass declares analyses which it keeps valid:
+ *     static constexpr AnalysisMask PreservedAnalyses;
+ * the rest of analyses are invalidated after the pass if it reports that the graph was changed
+ */
+class PassManager {
+public:
+    explicit PassManager(ir::Graph *graph) : graph_(graph), analysisManager_(graph) {}
+    NO_COPY_SEMANTIC(PassManager);
+    NO_MOVE_SEMANTIC(PassManager);
+    ~PassManager() = default;
+
+    /// @return true if the pass changed the graph
+    template <typename Pass>
+    bool Run()
+    {
+        auto isChanged = Pass(graph_, &analysisManager_).Run();
+        // unchanged graph keeps all analyses valid
+        if (isChanged) {
+            analysisManager_.Invalidate(Pass::PreservedAnalyses);
+        }
+        return isChanged;
+    }
+
+    AnalysisManager *GetAnalysisManager()
+    {
+        return &analysisManager_;
+    }
+
+private:
+    ir::Graph *graph_;
+    AnalysisManager analysisManager_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_PASS_MANAGER_H
@@ -0,0 +1,203 @@
+#ifndef ANALYSIS_PATTERN_MATCH_H
+#define ANALYSIS_PATTERN_MATCH_H
+
+#include "ir/common.h"
+#include "ir/instruction.h"
+
+#include <cstdint>
+
+/**
+ * Patterns over instruction trees built from templates, e.g.
+ *     pattern::Add(pattern::Value(&x), pattern::Const(0)).Match(inst)
+ * matches `Add x, 0` and `Add 0, x` binding x. Every pattern is a small struct with an inline Match method,
+ * so a composed pattern is compiled to straight-line checks of opcodes and inputs without indirect calls.
+ * Bindings are written while matching and are meaningful only if the whole pattern matched.
+ */
+namespace compiler::pattern {
+
+// Matches any instruction
+struct AnyPattern {
+    bool Match([[maybe_unused]] ir::Instruction *inst) const
+    {
+        return true;
+    }
+};
+
+// Matches any instruction and binds it
+struct ValuePattern {
+    ir::Instruction **value;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        *value = inst;
+        return true;
+    }
+};
+
+// Matches the given instruction only
+struct SpecificPattern {
+    ir::Instruction *value;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        return inst == value;
+    }
+};
+
+// Matches the instruction bound by a preceding part of the pattern. Bindings are not backtracked, so
+// Xor(Xor(Value(&x), Value(&y)), Same(&y)) does not match `Xor (Xor a, b), a`
+struct SamePattern {
+    ir::Instruction *const *value;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        return inst == *value;
+    }
+};
+
+// Matches any constant and binds its value
+struct AnyConstPattern {
+    int64_t *value;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        if (inst->GetOpcode() != ir::Opcode::CONSTANT) {
+            return false;
+        }
+        *value = inst->As<ir::AssignInst>()->GetValue();
+        return true;
+    }
+};
+
+// Matches constant with the given value
+struct ConstPattern {
+    int64_t value;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        return inst->GetOpcode() == ir::Opcode::CONSTANT && inst->As<ir::AssignInst>()->GetValue() == value;
+    }
+};
+
+// Matches the sub-pattern and binds the instruction matched by it
+template <typename Pattern>
+struct CapturePattern {
+    ir::Instruction **value;
+    Pattern pattern;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        if (!pattern.Match(inst)) {
+            return false;
+        }
+        *value = inst;
+        return true;
+    }
+};
+
+// Commutative patterns try the swapped inputs if the direct order does not match
+template <ir::Opcode Op, typename Lhs, typename Rhs, bool IsCommutative>
+struct BinaryPattern {
+    Lhs lhs;
+    Rhs rhs;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        if (inst->GetOpcode() != Op) {
+            return false;
+        }
+        auto *op1 = inst->GetInput(0);
+        auto *op2 = inst->GetInput(1);
+        if (lhs.Match(op1) && rhs.Match(op2)) {
+            return true;
+        }
+        if constexpr (IsCommutative) {
+            return lhs.Match(op2) && rhs.Match(op1);
+        }
+        return false;
+    }
+};
+
+// Matches comparison with the given flags, inputs of comparison are never swapped
+template <typename Lhs, typename Rhs>
+struct ComparePattern {
+    ir::CmpFlags flags;
+    Lhs lhs;
+    Rhs rhs;
+
+    bool Match(ir::Instruction *inst) const
+    {
+        return inst->GetOpcode() == ir::Opcode::COMPARE && inst->As<ir::LogicInst>()->GetCmpFlags() == flags &&
+               lhs.Match(inst->GetInput(0)) && rhs.Match(inst->GetInput(1));
+    }
+};
+
+inline AnyPattern Any()
+{
+    return {};
+}
+
+inline ValuePattern Value(ir::Instruction **value)
+{
+    return {value};
+}
+
+inline SpecificPattern Specific(ir::Instruction *value)
+{
+    return {value};
+}
+
+inline SamePattern Same(ir::Instruction *const *value)
+{
+    return {value};
+}
+
+inline AnyConstPattern AnyConst(int64_t *value)
+{
+    return {value};
+}
+
+inline ConstPattern Const(int64_t value)
+{
+    return {value};
+}
+
+template <typename Pattern>
+CapturePattern<Pattern> Capture(ir::Instruction **value, const Pattern &pattern)
+{
+    return {value, pattern};
+}
+
+template <typename Lhs, typename Rhs>
+BinaryPattern<ir::Opcode::ADD, Lhs, Rhs, true> Add(const Lhs &lhs, const Rhs &rhs)
+{
+    return {lhs, rhs};
+}
+
+template <typename Lhs, typename Rhs>
+BinaryPattern<ir::Opcode::MUL, Lhs, Rhs, true> Mul(const Lhs &lhs, const Rhs &rhs)
+{
+    return {lhs, rhs};
+}
+
+template <typename Lhs, typename Rhs>
+BinaryPattern<ir::Opcode::XOR, Lhs, Rhs, true> Xor(const Lhs &lhs, const Rhs &rhs)
+{
+    return {lhs, rhs};
+}
+
+template <typename Lhs, typename Rhs>
+BinaryPattern<ir::Opcode::SHL, Lhs, Rhs, false> Shl(const Lhs &lhs, const Rhs &rhs)
+{
+    return {lhs, rhs};
+}
+
+template <typename Lhs, typename Rhs>
+ComparePattern<Lhs, Rhs> Compare(ir::CmpFlags flags, const Lhs &lhs, const Rhs &rhs)
+{
+    return {flags, lhs, rhs};
+}
+
+}  // namespace compiler::pattern
+
+#endif  // ANALYSIS_PATTERN_MATCH_H
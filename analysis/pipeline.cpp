@@ -0,0 +1,46 @@
+#include "analysis/pipeline.h"
+#include "analysis/optimization.h"
+#include "analysis/pass_manager.h"
+#include "analysis/statistics.h"
+#include "ir/graph.h"
+#include "utils/macros.h"
+
+namespace compiler {
+
+size_t CompileMethod(ir::Graph *graph, OptLevel level)
+{
+    PassScope passScope {graph, "CompileMethod"};
+    PassManager passManager {graph};
+    size_t changedCount = 0;
+    switch (level) {
+        case OptLevel::O0:
+            break;
+        case OptLevel::O1:
+            changedCount += passManager.Run<PeepHoleOptimizer>() ? 1 : 0;
+            break;
+        case OptLevel::O2:
+            changedCount += passManager.Run<InliningOptimizer>() ? 1 : 0;
+            // folded constants may make values, branches and checks redundant, so passes are repeated while anything
+            // changes
+            for (size_t round = 0; round < MaxOptRounds; ++round) {
+                size_t roundChanges = 0;
+                roundChanges += passManager.Run<SCCPOptimizer>() ? 1 : 0;
+                roundChanges += passManager.Run<PeepHoleOptimizer>() ? 1 : 0;
+                roundChanges += passManager.Run<GVNOptimizer>() ? 1 : 0;
+                roundChanges += passManager.Run<LICMOptimizer>() ? 1 : 0;
+                roundChanges += passManager.Run<StrengthReductionOptimizer>() ? 1 : 0;
+                roundChanges += passManager.Run<DCEOptimizer>() ? 1 : 0;
+                roundChanges += passManager.Run<CheckOptimizer>() ? 1 : 0;
+                if (roundChanges == 0) {
+                    break;
+                }
+                changedCount += roundChanges;
+            }
+            break;
+        default:
+            UNREACHABLE();
+    }
+    return changedCount;
+}
+
+}  // namespace compiler
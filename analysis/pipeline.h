@@ -0,0 +1,34 @@
+#ifndef ANALYSIS_PIPELINE_H
+#define ANALYSIS_PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace compiler {
+
+namespace ir {
+class Graph;
+}  // namespace ir
+
+enum class OptLevel : uint8_t {
+    // no optimizations, the fastest startup
+    O0,
+    // single run of cheap peepholes, for lukewarm methods
+    O1,
+    // inlining, then constant propagation, peepholes, value numbering, loop invariant code motion, strength
+    // reduction, dead code and checks elimination until fixpoint, for hot methods
+    O2,
+};
+
+// Bound of optimization rounds at OptLevel::O2
+constexpr size_t MaxOptRounds = 8;
+
+/**
+ * Single entry point of the compiler: optimizes the method with the predefined pipeline of the level
+ * @return number of passes which changed the graph
+ */
+size_t CompileMethod(ir::Graph *graph, OptLevel level);
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_PIPELINE_H
@@ -0,0 +1,305 @@
+#include "analysis/range_analysis.h"
+#include "analysis/pattern_match.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+#include <algorithm>
+#include <array>
+
+namespace compiler {
+
+namespace {
+
+int64_t SaturatingAdd(int64_t value, int64_t delta)
+{
+    int64_t result = 0;
+    if (__builtin_add_overflow(value, delta, &result)) {
+        return delta < 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+    }
+    return result;
+}
+
+ValueRange AddRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    auto result = ValueRange {};
+    if (__builtin_add_overflow(lhs.min, rhs.min, &result.min) ||
+        __builtin_add_overflow(lhs.max, rhs.max, &result.max)) {
+        return ValueRange::Full();
+    }
+    return result;
+}
+
+ValueRange MulRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    std::array<int64_t, 4U> products {};
+    if (__builtin_mul_overflow(lhs.min, rhs.min, &products[0]) ||
+        __builtin_mul_overflow(lhs.min, rhs.max, &products[1]) ||
+        __builtin_mul_overflow(lhs.max, rhs.min, &products[2]) ||
+        __builtin_mul_overflow(lhs.max, rhs.max, &products[3])) {
+        return ValueRange::Full();
+    }
+    auto [minIt, maxIt] = std::minmax_element(products.begin(), products.end());
+    return {*minIt, *maxIt};
+}
+
+}  // namespace
+
+/* static */
+ValueRange ValueRange::OfType(ir::ResultType resType)
+{
+    if (resType == ir::ResultType::VOID || resType == ir::ResultType::INVALID || resType == ir::ResultType::U64) {
+        return Full();
+    }
+    auto bits = ir::GetResultTypeBits(resType);
+    if (ir::IsUnsignedResultType(resType)) {
+        return {0, static_cast<int64_t>((uint64_t {1} << bits) - 1U)};
+    }
+    if (bits == 64U) {
+        return Full();
+    }
+    auto bound = int64_t {1} << (bits - 1U);
+    return {-bound, bound - 1};
+}
+
+/* static */
+ValueRange ValueRange::Union(const ValueRange &lhs, const ValueRange &rhs)
+{
+    if (lhs.IsEmpty()) {
+        return rhs;
+    }
+    if (rhs.IsEmpty()) {
+        return lhs;
+    }
+    return {std::min(lhs.min, rhs.min), std::max(lhs.max, rhs.max)};
+}
+
+void RangeAnalysis::Run()
+{
+    PassScope passScope {graph_, "RangeAnalysis"};
+    const auto &rpo = analysisManager_->GetAnalysis<RPO>().GetRpoVector();
+    ComputeConditionBlocks(rpo, analysisManager_->GetAnalysis<DominatorsTree>());
+    inductionAnalysis_.Run();
+    ranges_.assign(graph_->GetInstIdsBound(), ValueRange {});
+    phiUpdates_.assign(graph_->GetInstIdsBound(), 0);
+
+    // every cycle of data flow goes through a phi, so widening of phis stops the iterations
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (auto *bb : rpo) {
+            bb->IterateOverInstructions([this, &isChanged](Instruction *inst) {
+                auto id = inst->GetInstId().GetId();
+                auto newRange = Evaluate(inst);
+                if (inst->GetOpcode() == ir::Opcode::PHI) {
+                    newRange = ValueRange::Union(ranges_[id], newRange);
+                    if (newRange != ranges_[id] && ++phiUpdates_[id] > WideningThreshold) {
+                        newRange = Widen(inst, ranges_[id], newRange);
+                    }
+                }
+                if (newRange != ranges_[id]) {
+                    ranges_[id] = newRange;
+                    isChanged = true;
+                }
+                return false;
+            });
+        }
+    }
+}
+
+ValueRange RangeAnalysis::GetRange(Instruction *inst) const
+{
+    auto id = inst->GetInstId().GetId();
+    return id < ranges_.size() ? ranges_[id] : ValueRange::Full();
+}
+
+ValueRange RangeAnalysis::GetRange(Instruction *inst, BasicBlock *bb) const
+{
+    ASSERT(bb->GetId() < conditionBlocks_.size());
+    auto range = GetRange(inst);
+    for (auto *condBB = conditionBlocks_[bb->GetId()]; condBB != nullptr && !range.IsEmpty();
+         condBB = outerConditionBlocks_[condBB->GetId()]) {
+        bool trueEdge = false;
+        auto *cmpInst = GetEdgeCondition(condBB, &trueEdge);
+        range = Narrow(range, inst, cmpInst, trueEdge);
+    }
+    return range;
+}
+
+void RangeAnalysis::ComputeConditionBlocks(const std::vector<BasicBlock *> &rpo, const DominatorsTree &domTree)
+{
+    conditionBlocks_.assign(graph_->GetBBIdsBound(), nullptr);
+    outerConditionBlocks_.assign(graph_->GetBBIdsBound(), nullptr);
+    // immediate dominator goes before the block in reverse post order
+    for (auto *bb : rpo) {
+        auto *dominator = domTree.GetImmediateDominator(bb);
+        auto *outerCondBB = dominator == nullptr ? nullptr : conditionBlocks_[dominator->GetId()];
+        bool trueEdge = false;
+        if (GetEdgeCondition(bb, &trueEdge) != nullptr) {
+            conditionBlocks_[bb->GetId()] = bb;
+            outerConditionBlocks_[bb->GetId()] = outerCondBB;
+        } else {
+            conditionBlocks_[bb->GetId()] = outerCondBB;
+        }
+    }
+}
+
+/* static */
+Instruction *RangeAnalysis::GetEdgeCondition(BasicBlock *bb, bool *trueEdge)
+{
+    if (bb->GetPredecessors().size() != 1) {
+        return nullptr;
+    }
+    auto *pred = *bb->GetPredecessors().begin();
+    auto *branchInst = pred->GetLastInstruction();
+    if (branchInst == nullptr || branchInst->GetOpcode() != ir::Opcode::COND_BRANCH ||
+        branchInst->GetInputs().Size() != 1 || pred->GetTrueSuccessor() == pred->GetFalseSuccessor()) {
+        return nullptr;
+    }
+    auto *cmpInst = branchInst->GetFirstOp();
+    if (cmpInst->GetOpcode() != ir::Opcode::COMPARE) {
+        return nullptr;
+    }
+    *trueEdge = pred->GetTrueSuccessor() == bb;
+    return cmpInst;
+}
+
+ValueRange RangeAnalysis::Narrow(ValueRange range, Instruction *inst, Instruction *cmpInst, bool trueEdge) const
+{
+    auto *less = cmpInst->GetFirstOp();
+    auto *greater = cmpInst->GetLastOp();
+    if ((less != inst && greater != inst) || less == greater) {
+        return range;
+    }
+    auto lessRange = less == inst ? range : GetRange(less);
+    auto greaterRange = greater == inst ? range : GetRange(greater);
+    // unsigned values are compared as signed ones only if both of them are not negative
+    auto isUnsigned = ir::IsUnsignedResultType(ir::CombineResultType(less, greater));
+    if (isUnsigned && (lessRange.min < 0 || greaterRange.min < 0)) {
+        return range;
+    }
+
+    // `less < greater` is false on the false edge, so `greater <= less` holds there
+    auto isStrict = cmpInst->As<ir::LogicInst>()->GetCmpFlags() == ir::CmpFlags::LT;
+    if (!trueEdge) {
+        std::swap(less, greater);
+        std::swap(lessRange, greaterRange);
+        isStrict = !isStrict;
+    }
+    int64_t gap = isStrict ? 1 : 0;
+    if (inst == less) {
+        range.max = std::min(range.max, SaturatingAdd(greaterRange.max, -gap));
+    } else {
+        range.min = std::max(range.min, SaturatingAdd(lessRange.min, gap));
+    }
+    return range;
+}
+
+ValueRange RangeAnalysis::Evaluate(Instruction *inst) const
+{
+    switch (inst->GetOpcode()) {
+        case ir::Opcode::CONSTANT: {
+            auto value = inst->As<ir::AssignInst>()->GetValue();
+            return {value, value};
+        }
+        case ir::Opcode::ADD:
+        case ir::Opcode::MUL:
+        case ir::Opcode::SHL:
+            return EvaluateArithm(inst);
+        case ir::Opcode::XOR: {
+            // operands of the type give a value of the type
+            auto typeRange = ValueRange::OfType(inst->GetResultType());
+            auto lhs = GetRange(inst->GetFirstOp());
+            auto rhs = GetRange(inst->GetLastOp());
+            if (lhs.IsEmpty() || rhs.IsEmpty()) {
+                return {};
+            }
+            return lhs.IsInside(typeRange) && rhs.IsInside(typeRange) ? typeRange : ValueRange::Full();
+        }
+        case ir::Opcode::COMPARE:
+            return {0, 1};
+        case ir::Opcode::PHI:
+            return EvaluatePhi(inst);
+        default:
+            // parameters, loads and calls may be any value of their type
+            return ValueRange::OfType(inst->GetResultType());
+    }
+}
+
+ValueRange RangeAnalysis::EvaluateArithm(Instruction *inst) const
+{
+    auto *bb = inst->GetBasicBlock();
+    auto lhs = GetRange(inst->GetFirstOp(), bb);
+    auto rhs = GetRange(inst->GetLastOp(), bb);
+    if (lhs.IsEmpty() || rhs.IsEmpty()) {
+        return {};
+    }
+
+    auto result = ValueRange {};
+    switch (inst->GetOpcode()) {
+        case ir::Opcode::ADD:
+            result = AddRanges(lhs, rhs);
+            break;
+        case ir::Opcode::MUL:
+            result = MulRanges(lhs, rhs);
+            break;
+        case ir::Opcode::SHL: {
+            // shift is a multiplication by a power of two while the shift is less than the type width
+            auto bits = static_cast<int64_t>(ir::GetResultTypeBits(inst->GetResultType()));
+            if (rhs.min < 0 || rhs.max >= std::min<int64_t>(bits, 63)) {
+                return ValueRange::Full();
+            }
+            result = MulRanges(lhs, {int64_t {1} << rhs.min, int64_t {1} << rhs.max});
+            break;
+        }
+        default:
+            UNREACHABLE();
+    }
+    // the result is wrapped around on overflow of its type
+    return result.IsInside(ValueRange::OfType(inst->GetResultType())) ? result : ValueRange::Full();
+}
+
+ValueRange RangeAnalysis::EvaluatePhi(Instruction *phiInst) const
+{
+    // the header is entered at most trip count + 1 times, the variable may be other than the tested one
+    const auto *var = inductionAnalysis_.GetInductionVariable(phiInst);
+    int64_t start = 0;
+    if (var != nullptr && var->IsBasic() && pattern::AnyConst(&start).Match(var->start)) {
+        auto tripCount = inductionAnalysis_.GetTripCount(var->loop);
+        int64_t last = 0;
+        if (tripCount.has_value() && !__builtin_mul_overflow(var->step, *tripCount, &last) &&
+            !__builtin_add_overflow(start, last, &last)) {
+            auto values = ValueRange {std::min(start, last), std::max(start, last)};
+            if (values.IsInside(ValueRange::OfType(phiInst->GetResultType()))) {
+                return values;
+            }
+        }
+    }
+
+    auto *phi = phiInst->As<ir::PhiInst>();
+    auto result = ValueRange {};
+    for (size_t idx = 0; idx < phi->GetInputs().Size(); ++idx) {
+        // the value comes at the end of the incoming block
+        result = ValueRange::Union(result, GetRange(phi->GetInput(idx), phi->GetIncomingBlock(idx)));
+    }
+    return result;
+}
+
+ValueRange RangeAnalysis::Widen(Instruction *phiInst, const ValueRange &oldRange, ValueRange newRange) const
+{
+    auto typeRange = ValueRange::OfType(phiInst->GetResultType());
+    // the bound goes to the limit of the type first, the result may still overflow it
+    if (newRange.min < oldRange.min) {
+        newRange.min = oldRange.min > typeRange.min ? std::min(newRange.min, typeRange.min)
+                                                    : std::numeric_limits<int64_t>::min();
+    }
+    if (newRange.max > oldRange.max) {
+        newRange.max = oldRange.max < typeRange.max ? std::max(newRange.max, typeRange.max)
+                                                    : std::numeric_limits<int64_t>::max();
+    }
+    return newRange;
+}
+
+}  // namespace compiler
@@ -0,0 +1,107 @@
+#ifndef ANALYSIS_RANGE_ANALYSIS_H
+#define ANALYSIS_RANGE_ANALYSIS_H
+
+#include "analysis/analysis.h"
+#include "analysis/induction_analysis.h"
+#include "analysis/pass_manager.h"
+#include "ir/common.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace compiler {
+
+// Closed interval of values, empty if min is greater than max
+struct ValueRange {
+    int64_t min {std::numeric_limits<int64_t>::max()};
+    int64_t max {std::numeric_limits<int64_t>::min()};
+
+    static ValueRange Full()
+    {
+        return {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+    }
+
+    // Values of the type, unsigned 64 bit values are not representable and get the full range
+    static ValueRange OfType(ir::ResultType resType);
+
+    bool IsEmpty() const
+    {
+        return min > max;
+    }
+
+    bool IsInside(const ValueRange &other) const
+    {
+        return IsEmpty() || (other.min <= min && max <= other.max);
+    }
+
+    static ValueRange Union(const ValueRange &lhs, const ValueRange &rhs);
+
+    bool operator==(const ValueRange &other) const
+    {
+        return min == other.min && max == other.max;
+    }
+
+    bool operator!=(const ValueRange &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * Interval analysis over SSA. Ranges of ADD, MUL and SHL are derived from ranges of their inputs, an overflow of
+ * the result type gives the full range. Inputs are narrowed by COMPARE LE/LT of conditional branches whose edges
+ * lead to the instruction. Ranges of phis grow until the fixed point is reached, phis which keep growing are
+ * widened to their type and then to the full range, so loops are analysed in a few iterations. Basic induction
+ * variables of loops with a known trip count get the exact range of their values
+ */
+class RangeAnalysis {
+public:
+    RangeAnalysis(Graph *graph, AnalysisManager *analysisManager)
+        : graph_(graph), analysisManager_(analysisManager), inductionAnalysis_(graph, analysisManager)
+    {
+    }
+
+    void Run();
+
+    // Range of the value wherever it is used, instructions created after the analysis get the full range
+    ValueRange GetRange(Instruction *inst) const;
+
+    // Range of the value inside of the block narrowed by conditions of branches which dominate the block
+    ValueRange GetRange(Instruction *inst, BasicBlock *bb) const;
+
+private:
+    // Number of updates after which the range of a phi is widened
+    static constexpr uint32_t WideningThreshold = 2;
+
+    // Nearest block on the dominators path from the block which is entered only by an edge of a compare branch
+    void ComputeConditionBlocks(const std::vector<BasicBlock *> &rpo, const DominatorsTree &domTree);
+
+    /// @return compare which is true on the edge to bb if trueEdge is set or false otherwise, nullptr if there is none
+    static Instruction *GetEdgeCondition(BasicBlock *bb, bool *trueEdge);
+
+    ValueRange Narrow(ValueRange range, Instruction *inst, Instruction *cmpInst, bool trueEdge) const;
+
+    ValueRange Evaluate(Instruction *inst) const;
+
+    ValueRange EvaluateArithm(Instruction *inst) const;
+
+    ValueRange EvaluatePhi(Instruction *phiInst) const;
+
+    ValueRange Widen(Instruction *phiInst, const ValueRange &oldRange, ValueRange newRange) const;
+
+    Graph *graph_;
+    AnalysisManager *analysisManager_;
+    InductionAnalysis inductionAnalysis_;
+    // indexed by instruction id
+    std::vector<ValueRange> ranges_;
+    std::vector<uint32_t> phiUpdates_;
+    // indexed by block id
+    std::vector<BasicBlock *> conditionBlocks_;
+    // next condition block up the dominators path of a condition block
+    std::vector<BasicBlock *> outerConditionBlocks_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_RANGE_ANALYSIS_H
@@ -0,0 +1,122 @@
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+
+namespace compiler {
+
+namespace {
+
+size_t CountInstructions(ir::Graph *graph)
+{
+    size_t instCount = 0;
+    graph->IterateOverBlocks([&instCount](ir::BasicBlock *bb) { instCount += bb->GetAliveInstructionCount(); });
+    return instCount;
+}
+
+void DumpJsonString(std::ostream &os, std::string_view str)
+{
+    os << '"';
+    for (auto symbol : str) {
+        if (symbol == '"' || symbol == '\\') {
+            os << '\\';
+        }
+        os << symbol;
+    }
+    os << '"';
+}
+
+}  // namespace
+
+const char *StatCounterToString(StatCounter counter)
+{
+    switch (counter) {
+        case StatCounter::FOLDED_CONSTANTS:
+            return "folded_constants";
+        case StatCounter::SIMPLIFIED_INSTS:
+            return "simplified_insts";
+        case StatCounter::ELIMINATED_CHECKS:
+            return "eliminated_checks";
+        case StatCounter::INLINED_CALLS:
+            return "inlined_calls";
+        case StatCounter::REDUNDANT_INSTS:
+            return "redundant_insts";
+        case StatCounter::REMOVED_INSTS:
+            return "removed_insts";
+        case StatCounter::REMOVED_BLOCKS:
+            return "removed_blocks";
+        case StatCounter::FOLDED_BRANCHES:
+            return "folded_branches";
+        case StatCounter::HOISTED_INSTS:
+            return "hoisted_insts";
+        case StatCounter::REDUCED_INDUCTIONS:
+            return "reduced_inductions";
+        default:
+            UNREACHABLE();
+    }
+}
+
+uint64_t CompilerStatistics::GetTotalCounter(StatCounter counter, std::string_view passName) const
+{
+    uint64_t total = 0;
+    for (const auto &record : records_) {
+        if (passName.empty() || record.passName == passName) {
+            total += record.GetCounter(counter);
+        }
+    }
+    return total;
+}
+
+size_t CompilerStatistics::OpenRecord(ir::Graph *graph, std::string_view passName)
+{
+    auto &record = records_.emplace_back();
+    record.passName = passName;
+    record.methodName = graph->GetMethodName();
+    record.depth = openRecords_.size();
+    record.allocatedBytes = graph->GetAllocator()->GetAllocatedBytes();
+    record.instsBefore = CountInstructions(graph);
+    record.blocksBefore = graph->GetBlocksCount();
+    openRecords_.push_back(records_.size() - 1);
+    return records_.size() - 1;
+}
+
+void CompilerStatistics::CloseRecord(ir::Graph *graph, size_t recordIdx, uint64_t timeNs)
+{
+    ASSERT(!openRecords_.empty() && openRecords_.back() == recordIdx);
+    openRecords_.pop_back();
+    auto &record = records_[recordIdx];
+    record.timeNs = timeNs;
+    // allocatedBytes keeps the arena size at the start of the pass
+    record.allocatedBytes = graph->GetAllocator()->GetAllocatedBytes() - record.allocatedBytes;
+    record.instsAfter = CountInstructions(graph);
+    record.blocksAfter = graph->GetBlocksCount();
+}
+
+void CompilerStatistics::DumpJson(std::ostream &os) const
+{
+    os << "{\"passes\": [";
+    for (size_t idx = 0; idx < records_.size(); ++idx) {
+        const auto &record = records_[idx];
+        os << (idx == 0 ? "\n" : ",\n") << "  {\"pass\": ";
+        DumpJsonString(os, record.passName);
+        os << ", \"method\": ";
+        DumpJsonString(os, record.methodName);
+        os << ", \"depth\": " << record.depth << ", \"time_ns\": " << record.timeNs
+           << ", \"allocated_bytes\": " << record.allocatedBytes << ", \"insts_before\": " << record.instsBefore
+           << ", \"insts_after\": " << record.instsAfter << ", \"blocks_before\": " << record.blocksBefore
+           << ", \"blocks_after\": " << record.blocksAfter << ", \"counters\": {";
+        for (size_t counterIdx = 0; counterIdx < CountersCount; ++counterIdx) {
+            os << (counterIdx == 0 ? "\"" : ", \"") << StatCounterToString(static_cast<StatCounter>(counterIdx))
+               << "\": " << record.counters[counterIdx];
+        }
+        os << "}}";
+    }
+    os << (records_.empty() ? "]}\n" : "\n]}\n");
+}
+
+void CompilerStatistics::Clear()
+{
+    ASSERT(openRecords_.empty());
+    records_.clear();
+}
+
+}  // namespace compiler
@@ -0,0 +1,144 @@
+#ifndef ANALYSIS_STATISTICS_H
+#define ANALYSIS_STATISTICS_H
+
+#include "ir/graph.h"
+#include "utils/macros.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace compiler {
+
+// Pass specific events
+enum class StatCounter : uint8_t {
+    // arithmetic with constant inputs replaced by a constant
+    FOLDED_CONSTANTS,
+    // instructions replaced by their input or by a cheaper instruction
+    SIMPLIFIED_INSTS,
+    ELIMINATED_CHECKS,
+    INLINED_CALLS,
+    // instructions replaced by an equal dominating instruction
+    REDUNDANT_INSTS,
+    // instructions without side effects and users
+    REMOVED_INSTS,
+    REMOVED_BLOCKS,
+    // conditional branches replaced by unconditional ones
+    FOLDED_BRANCHES,
+    // loop invariant instructions moved to pre-headers
+    HOISTED_INSTS,
+    // derived induction variables replaced by phis incremented on every iteration
+    REDUCED_INDUCTIONS,
+    COUNT,
+};
+
+const char *StatCounterToString(StatCounter counter);
+
+// Opt-in collector of compile time statistics. It is attached to graphs with Graph::SetStatistics and may be shared
+// by many methods, passes and analyses of such graphs are recorded through PassScope
+class CompilerStatistics {
+public:
+    static constexpr auto CountersCount = static_cast<size_t>(StatCounter::COUNT);
+
+    struct PassRecord {
+        std::string passName;
+        std::string methodName;
+        // number of passes which were running when this one started
+        uint32_t depth {0};
+        uint64_t timeNs {0};
+        // bytes allocated in the arena of the graph, memory of nested passes is included
+        size_t allocatedBytes {0};
+        size_t instsBefore {0};
+        size_t instsAfter {0};
+        size_t blocksBefore {0};
+        size_t blocksAfter {0};
+        std::array<uint64_t, CountersCount> counters {};
+
+        uint64_t GetCounter(StatCounter counter) const
+        {
+            return counters[static_cast<size_t>(counter)];
+        }
+    };
+
+    explicit CompilerStatistics() = default;
+    NO_COPY_SEMANTIC(CompilerStatistics);
+    NO_MOVE_SEMANTIC(CompilerStatistics);
+    ~CompilerStatistics() = default;
+
+    // Records are ordered by the start of passes
+    const std::vector<PassRecord> &GetRecords() const
+    {
+        return records_;
+    }
+
+    // Sum of the counter over all records with the pass name, empty name matches every pass
+    uint64_t GetTotalCounter(StatCounter counter, std::string_view passName = {}) const;
+
+    /// @return index of the new record
+    size_t OpenRecord(ir::Graph *graph, std::string_view passName);
+
+    // Must be called in reverse order of OpenRecord
+    void CloseRecord(ir::Graph *graph, size_t recordIdx, uint64_t timeNs);
+
+    // Counter is added to the innermost running pass
+    void AddCounter(StatCounter counter, uint64_t value)
+    {
+        ASSERT(!openRecords_.empty());
+        records_[openRecords_.back()].counters[static_cast<size_t>(counter)] += value;
+    }
+
+    // Writes {"passes": [...]} with a JSON object per record
+    void DumpJson(std::ostream &os) const;
+
+    void Clear();
+
+private:
+    std::vector<PassRecord> records_;
+    // stack of records of running passes
+    std::vector<size_t> openRecords_;
+};
+
+// Records the pass from construction till destruction if statistics are collected for the graph
+class PassScope {
+public:
+    PassScope(ir::Graph *graph, std::string_view passName) : graph_(graph), statistics_(graph->GetStatistics())
+    {
+        if (UNLIKELY(statistics_ != nullptr)) {
+            recordIdx_ = statistics_->OpenRecord(graph_, passName);
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    NO_COPY_SEMANTIC(PassScope);
+    NO_MOVE_SEMANTIC(PassScope);
+
+    ~PassScope()
+    {
+        if (UNLIKELY(statistics_ != nullptr)) {
+            auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+            statistics_->CloseRecord(graph_, recordIdx_, time.count());
+        }
+    }
+
+private:
+    ir::Graph *graph_;
+    CompilerStatistics *statistics_;
+    size_t recordIdx_ {0};
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Does nothing if statistics are not collected for the graph
+inline void CountStatistic(ir::Graph *graph, StatCounter counter, uint64_t value = 1)
+{
+    if (auto *statistics = graph->GetStatistics(); UNLIKELY(statistics != nullptr)) {
+        statistics->AddCounter(counter, value);
+    }
+}
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_STATISTICS_H
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/id.h"
+#include "ir/instruction.h"
+#include "ir/ir_builder.h"
+#include "utils/arena_allocator.h"
+
+#include <vector>
+
+namespace compiler::benchmarks {
+
+namespace {
+
+ir::Instruction *CreateAdd(ir::BasicBlock *bb, ir::Id id)
+{
+    return new ir::ArithmInst(bb, ir::InstId {id}, ir::Opcode::ADD, ir::ResultType::S32, ir::InstProxyList {});
+}
+
+ir::Instruction *CreateAdd(utils::ArenaAllocator *allocator, ir::BasicBlock *bb, ir::Id id)
+{
+    return allocator->New<ir::ArithmInst>(bb, ir::InstId {id}, ir::Opcode::ADD, ir::ResultType::S32,
+                                          ir::InstProxyList {});
+}
+
+}  // namespace
+
+// Every instruction is a separate malloc/free pair (allocation scheme before the graph arena)
+void HeapAllocInstructions(benchmark::State &state)
+{
+    auto graph = ir::Graph {};
+    auto *bb = ir::BasicBlock::Create(&graph);
+    auto instCount = static_cast<ir::Id>(state.range(0));
+    std::vector<ir::Instruction *> insts(instCount);
+    for ([[maybe_unused]] auto _ : state) {
+        for (ir::Id id = 0; id < instCount; ++id) {
+            insts[id] = CreateAdd(bb, id);
+        }
+        for (auto *inst : insts) {
+            delete inst;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * instCount);
+}
+
+// Instructions are bumped out of an arena and released together with it
+void ArenaAllocInstructions(benchmark::State &state)
+{
+    auto graph = ir::Graph {};
+    auto *bb = ir::BasicBlock::Create(&graph);
+    auto instCount = static_cast<ir::Id>(state.range(0));
+    std::vector<ir::Instruction *> insts(instCount);
+    for ([[maybe_unused]] auto _ : state) {
+        utils::ArenaAllocator allocator;
+        for (ir::Id id = 0; id < instCount; ++id) {
+            insts[id] = CreateAdd(&allocator, bb, id);
+        }
+        for (auto *inst : insts) {
+            inst->~Instruction();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * instCount);
+}
+
+// Build and destroy a straight-line method of `range(0)` blocks through IRBuilder
+void BuildAndDestroyGraph(benchmark::State &state)
+{
+    auto blocksCount = state.range(0);
+    for ([[maybe_unused]] auto _ : state) {
+        auto graph = ir::Graph {};
+        auto irBuilder = ir::IRBuilder {&graph};
+
+        auto *startBB = ir::BasicBlock::Create(&graph);
+        irBuilder.SetInsertionPoint(startBB);
+        auto *param = irBuilder.CreateParam(ir::ResultType::S32, 0);
+        auto *one = irBuilder.CreateConstInt(1);
+
+        ir::Instruction *value = param;
+        for (auto idx = 0; idx < blocksCount; ++idx) {
+            auto *bb = ir::BasicBlock::Create(&graph);
+            irBuilder.CreateBr(bb);
+            irBuilder.SetInsertionPoint(bb);
+            value = irBuilder.CreateAdd(value, one);
+            value = irBuilder.CreateXor(value, param);
+            value = irBuilder.CreateShl(value, one);
+        }
+        irBuilder.CreateRet(value);
+        benchmark::DoNotOptimize(graph.GetStartBlock());
+    }
+    state.SetItemsProcessed(state.iterations() * blocksCount);
+}
+
+BENCHMARK(HeapAllocInstructions)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(ArenaAllocInstructions)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(BuildAndDestroyGraph)->RangeMultiplier(8)->Range(8, 4096);
+
+}  // namespace compiler::benchmarks
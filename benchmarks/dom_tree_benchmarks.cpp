@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/analysis.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace compiler::benchmarks {
+
+namespace {
+
+/**
+ *  Chain of `diamondsCount` diamonds, every fourth diamond closes a loop back to its head:
+ *
+ *        head
+ *       /    \
+ *    left    right
+ *       \    /
+ *        join ---> next head
+ */
+void BuildDiamondsChain(ir::Graph *graph, int64_t diamondsCount)
+{
+    auto *prev = ir::BasicBlock::Create(graph);
+    for (int64_t idx = 0; idx < diamondsCount; ++idx) {
+        auto *head = ir::BasicBlock::Create(graph);
+        auto *left = ir::BasicBlock::Create(graph);
+        auto *right = ir::BasicBlock::Create(graph);
+        auto *join = ir::BasicBlock::Create(graph);
+        prev->SetTrueSuccessor(head);
+        head->SetTrueSuccessor(left);
+        head->SetFalseSuccessor(right);
+        left->SetTrueSuccessor(join);
+        right->SetTrueSuccessor(join);
+        if (idx % 4 == 3) {
+            join->SetFalseSuccessor(head);
+        }
+        prev = join;
+    }
+}
+
+}  // namespace
+
+// range(0) is the number of blocks in the graph
+void DominatorsTreeScaling(benchmark::State &state)
+{
+    auto graph = ir::Graph {};
+    BuildDiamondsChain(&graph, state.range(0) / 4);
+    for ([[maybe_unused]] auto _ : state) {
+        DominatorsTree domTree {&graph};
+        domTree.Run();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * graph.GetBlocksCount());
+    state.SetComplexityN(graph.GetBlocksCount());
+}
+
+// range(0) is the number of blocks in the graph, every block is queried against the start block and its neighbour
+void DominanceQueries(benchmark::State &state)
+{
+    auto graph = ir::Graph {};
+    BuildDiamondsChain(&graph, state.range(0) / 4);
+    DominatorsTree domTree {&graph};
+    domTree.Run();
+    std::vector<ir::BasicBlock *> blocks;
+    graph.IterateOverBlocks([&blocks](ir::BasicBlock *bb) { blocks.push_back(bb); });
+    for ([[maybe_unused]] auto _ : state) {
+        for (size_t idx = 1; idx < blocks.size(); ++idx) {
+            benchmark::DoNotOptimize(domTree.DoesBlockDominatesOn(blocks[idx], blocks.front()));
+            benchmark::DoNotOptimize(domTree.GetImmediateDominatorFor(blocks[idx - 1], blocks[idx]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (blocks.size() - 1));
+    state.SetComplexityN(graph.GetBlocksCount());
+}
+
+BENCHMARK(DominatorsTreeScaling)->RangeMultiplier(10)->Range(100, 100000)->Complexity();
+BENCHMARK(DominanceQueries)->RangeMultiplier(10)->Range(100, 100000)->Complexity();
+
+}  // namespace compiler::benchmarks
@@ -0,0 +1,342 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/analysis.h"
+#include "analysis/loop_analysis.h"
+#include "analysis/optimization.h"
+#include "analysis/pass_manager.h"
+#include "analysis/pipeline.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/graph_generator.h"
+#include "ir/instruction.h"
+#include "ir/ir_builder.h"
+
+#include <sys/resource.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace compiler::benchmarks {
+
+namespace {
+
+enum class Shape : int64_t {
+    // every body block jumps straight to the next one
+    STRAIGHT,
+    // bodies are split into diamonds which are joined with phis
+    DIAMONDS,
+};
+
+// Caller with `bodiesCount` bodies of arithmetic, memory accesses with checks and a call of a small callee
+struct Method {
+    Method() = default;
+    NO_COPY_SEMANTIC(Method);
+    NO_MOVE_SEMANTIC(Method);
+    ~Method() = default;
+
+    ir::CallGraph callGraph;
+    ir::Graph callee {&callGraph, "callee"};
+    ir::Graph caller {&callGraph, "caller"};
+};
+
+void BuildCallee(ir::Graph *graph)
+{
+    auto irBuilder = ir::IRBuilder {graph};
+    auto *startBB = ir::BasicBlock::Create(graph);
+    auto *bb = ir::BasicBlock::Create(graph);
+
+    irBuilder.SetInsertionPoint(startBB);
+    auto *param = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *seven = irBuilder.CreateConstInt(7);
+    irBuilder.CreateBr(bb);
+
+    irBuilder.SetInsertionPoint(bb);
+    auto *shl = irBuilder.CreateShl(param, seven);
+    irBuilder.CreateRet(irBuilder.CreateAdd(shl, param));
+}
+
+/**
+ *  Body of the caller, the diamond part is present only in Shape::DIAMONDS:
+ *
+ *     head:  arithmetic with foldable patterns, memory with redundant checks
+ *      /  \
+ *   left  right
+ *      \  /
+ *     join:  phi, call of the callee
+ */
+void BuildCaller(ir::Graph *graph, ir::MethodId calleeId, int64_t bodiesCount, Shape shape)
+{
+    auto irBuilder = ir::IRBuilder {graph};
+    auto *startBB = ir::BasicBlock::Create(graph);
+    irBuilder.SetInsertionPoint(startBB);
+    auto *param = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *zero = irBuilder.CreateConstInt(0);
+    auto *ten = irBuilder.CreateConstInt(10);
+
+    ir::Instruction *value = param;
+    for (int64_t idx = 0; idx < bodiesCount; ++idx) {
+        auto *head = ir::BasicBlock::Create(graph);
+        irBuilder.CreateBr(head);
+        irBuilder.SetInsertionPoint(head);
+        value = irBuilder.CreateAdd(value, zero);
+        value = irBuilder.CreateXor(value, param);
+        value = irBuilder.CreateShl(value, zero);
+        auto *mem = irBuilder.CreateMemory(ir::ResultType::S32, ten);
+        irBuilder.CreateNullCheck(mem);
+        irBuilder.CreateBoundCheck(mem, zero);
+        irBuilder.CreateStore(mem, zero, value);
+        irBuilder.CreateNullCheck(mem);
+        irBuilder.CreateBoundCheck(mem, zero);
+        value = irBuilder.CreateLoad(mem, zero);
+
+        auto *join = ir::BasicBlock::Create(graph);
+        if (shape == Shape::DIAMONDS) {
+            auto *left = ir::BasicBlock::Create(graph);
+            auto *right = ir::BasicBlock::Create(graph);
+            irBuilder.CreateCondBr(irBuilder.CreateCmpLT(value, param), left, right);
+
+            irBuilder.SetInsertionPoint(left);
+            auto *leftValue = irBuilder.CreateAdd(value, value);
+            irBuilder.CreateBr(join);
+            irBuilder.SetInsertionPoint(right);
+            auto *rightValue = irBuilder.CreateXor(value, value);
+            irBuilder.CreateBr(join);
+
+            irBuilder.SetInsertionPoint(join);
+            auto *phi = irBuilder.CreatePhi(ir::ResultType::S32);
+            phi->ResolveDependency(leftValue, left);
+            phi->ResolveDependency(rightValue, right);
+            value = phi;
+        } else {
+            irBuilder.CreateBr(join);
+            irBuilder.SetInsertionPoint(join);
+        }
+        // calls stay in blocks with unconditional successor, inliner splits such blocks
+        value = irBuilder.CreateCallStatic(calleeId, ir::ResultType::S32, {value});
+    }
+    irBuilder.CreateRet(value);
+}
+
+// Caller whose bodies call the callee twice with the same argument, so inlined bodies are redundant in pairs
+void BuildRepeatedCallsCaller(ir::Graph *graph, ir::MethodId calleeId, int64_t bodiesCount)
+{
+    auto irBuilder = ir::IRBuilder {graph};
+    auto *startBB = ir::BasicBlock::Create(graph);
+    irBuilder.SetInsertionPoint(startBB);
+    ir::Instruction *value = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    for (int64_t idx = 0; idx < bodiesCount; ++idx) {
+        auto *bb = ir::BasicBlock::Create(graph);
+        irBuilder.CreateBr(bb);
+        irBuilder.SetInsertionPoint(bb);
+        auto *first = irBuilder.CreateCallStatic(calleeId, ir::ResultType::S32, {value});
+        auto *second = irBuilder.CreateCallStatic(calleeId, ir::ResultType::S32, {value});
+        value = irBuilder.CreateXor(first, second);
+    }
+    irBuilder.CreateRet(value);
+}
+
+void BuildMethod(Method *method, const benchmark::State &state)
+{
+    BuildCallee(&method->callee);
+    BuildCaller(&method->caller, method->callee.GetMethodId(), state.range(0), static_cast<Shape>(state.range(1)));
+}
+
+size_t CountInstructions(ir::Graph *graph)
+{
+    size_t instCount = 0;
+    graph->IterateOverBlocks([&instCount](ir::BasicBlock *bb) { instCount += bb->GetAliveInstructionCount(); });
+    return instCount;
+}
+
+struct GraphSizes {
+    // size of the graph passed to the measured code
+    size_t instCount {0};
+    // sizes of the resulting graph
+    size_t blocksCount {0};
+    size_t arenaBytes {0};
+};
+
+void ReportCounters(benchmark::State &state, const GraphSizes &sizes)
+{
+    state.SetItemsProcessed(state.iterations() * sizes.instCount);
+    state.counters["insts"] = sizes.instCount;
+    state.counters["blocks"] = sizes.blocksCount;
+    state.counters["arena_bytes"] = sizes.arenaBytes;
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    // ru_maxrss is measured in kilobytes on linux
+    state.counters["peak_rss_bytes"] = static_cast<double>(usage.ru_maxrss) * 1024;
+}
+
+struct RpoAnalysis {
+    explicit RpoAnalysis(ir::Graph *graph) : graph_(graph), rpo_(graph) {}
+
+    void Run()
+    {
+        // measure traversal rather than copy of the cached order
+        graph_->InvalidateCfg();
+        rpo_.Run();
+    }
+
+    ir::Graph *graph_;
+    RPO rpo_;
+};
+
+struct Pipeline {
+    explicit Pipeline(ir::Graph *graph) : graph_(graph) {}
+
+    void Run()
+    {
+        PassManager passManager {graph_};
+        passManager.Run<InliningOptimizer>();
+        passManager.Run<PeepHoleOptimizer>();
+        passManager.Run<CheckOptimizer>();
+    }
+
+    ir::Graph *graph_;
+};
+
+template <OptLevel Level>
+struct Compile {
+    explicit Compile(ir::Graph *graph) : graph_(graph) {}
+
+    void Run()
+    {
+        CompileMethod(graph_, Level);
+    }
+
+    ir::Graph *graph_;
+};
+
+}  // namespace
+
+// Analyses keep the graph untouched, so it is built once
+template <typename Analysis>
+void RunAnalysis(benchmark::State &state)
+{
+    Method method;
+    BuildMethod(&method, state);
+    auto *graph = &method.caller;
+    for ([[maybe_unused]] auto _ : state) {
+        Analysis analysis {graph};
+        analysis.Run();
+        benchmark::ClobberMemory();
+    }
+    ReportCounters(state, {CountInstructions(graph), graph->GetBlocksCount(), graph->GetAllocator()->GetReservedBytes()});
+}
+
+// Optimizations modify the graph, so it is rebuilt out of the measured time before every run
+template <typename Pass>
+void RunPass(benchmark::State &state)
+{
+    GraphSizes sizes;
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        {
+            Method method;
+            BuildMethod(&method, state);
+            sizes.instCount = CountInstructions(&method.caller);
+            state.ResumeTiming();
+
+            Pass(&method.caller).Run();
+
+            state.PauseTiming();
+            sizes.blocksCount = method.caller.GetBlocksCount();
+            sizes.arenaBytes = method.caller.GetAllocator()->GetReservedBytes();
+        }
+        state.ResumeTiming();
+    }
+    ReportCounters(state, sizes);
+}
+
+// Arguments: number of bodies, Shape
+void MethodSizes(benchmark::internal::Benchmark *benchmark)
+{
+    for (auto shape : {Shape::STRAIGHT, Shape::DIAMONDS}) {
+        for (int64_t bodiesCount = 16; bodiesCount <= 1024; bodiesCount *= 8) {
+            benchmark->Args({bodiesCount, static_cast<int64_t>(shape)});
+        }
+    }
+    benchmark->ArgNames({"bodies", "shape"});
+}
+
+// Pipeline over seeded random methods: range(0) is the number of blocks of every method, range(1) is the maximal
+// loop depth. The root method calls two other generated methods
+void GeneratedPipeline(benchmark::State &state)
+{
+    auto options = ir::GeneratorOptions {};
+    options.blocksCount = state.range(0);
+    options.maxLoopDepth = state.range(1);
+    options.methodsCount = 3;
+    options.callsPerMethod = 2;
+
+    GraphSizes sizes;
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        {
+            auto callGraph = ir::CallGraph {};
+            auto methods = ir::GraphGenerator {options}.GenerateMethods(&callGraph);
+            auto *root = methods.front().get();
+            sizes.instCount = CountInstructions(root);
+            state.ResumeTiming();
+
+            Pipeline(root).Run();
+
+            state.PauseTiming();
+            sizes.blocksCount = root->GetBlocksCount();
+            sizes.arenaBytes = root->GetAllocator()->GetReservedBytes();
+        }
+        state.ResumeTiming();
+    }
+    ReportCounters(state, sizes);
+}
+
+// Value numbering of inlined code: range(0) is the number of bodies with two equal calls. Inlining and removal of
+// phis of inlined returns are not measured
+void InlinedGVN(benchmark::State &state)
+{
+    GraphSizes sizes;
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        {
+            Method method;
+            BuildCallee(&method.callee);
+            BuildRepeatedCallsCaller(&method.caller, method.callee.GetMethodId(), state.range(0));
+            InliningOptimizer(&method.caller).Run();
+            PeepHoleOptimizer(&method.caller).Run();
+            sizes.instCount = CountInstructions(&method.caller);
+            state.ResumeTiming();
+
+            GVNOptimizer(&method.caller).Run();
+
+            state.PauseTiming();
+            sizes.blocksCount = method.caller.GetBlocksCount();
+            sizes.arenaBytes = method.caller.GetAllocator()->GetReservedBytes();
+        }
+        state.ResumeTiming();
+    }
+    ReportCounters(state, sizes);
+}
+
+BENCHMARK_TEMPLATE(RunAnalysis, DFS)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunAnalysis, RpoAnalysis)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunAnalysis, DominatorsTree)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunAnalysis, LoopAnalysis)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, PeepHoleOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, CheckOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, InliningOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, GVNOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, DCEOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, SCCPOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, LICMOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, StrengthReductionOptimizer)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, Pipeline)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, Compile<OptLevel::O1>)->Apply(MethodSizes);
+BENCHMARK_TEMPLATE(RunPass, Compile<OptLevel::O2>)->Apply(MethodSizes);
+BENCHMARK(InlinedGVN)->RangeMultiplier(8)->Range(16, 1024)->ArgNames({"bodies"});
+BENCHMARK(GeneratedPipeline)->ArgsProduct({{64, 512, 4096}, {0, 3}})->ArgNames({"blocks", "loop_depth"});
+
+}  // namespace compiler::benchmarks
@@ -11,6 +11,7 @@ void BasicBlock::InsertInstBack(Instruction *inst)
 {
     ASSERT(!inst->GetInstId().IsPhi());
     instructions_.PushBack(inst);
+    UpdateInstructionOrder(inst);
 }
 
 void BasicBlock::InsertPhiInst(Instruction *inst)
@@ -22,16 +23,36 @@ void BasicBlock::InsertPhiInst(Instruction *inst)
         inst->LinkBefore(lastPhiInst_->next_);
     }
     lastPhiInst_ = inst;
+    UpdateInstructionOrder(inst);
+}
+
+void BasicBlock::RemovePhiInst(Instruction *inst)
+{
+    ASSERT(inst->GetInstId().IsPhi() && inst->GetBasicBlock() == this);
+    if (lastPhiInst_ == inst) {
+        // phis are placed at the beginning of the block, so the previous instruction is a phi as well
+        lastPhiInst_ = inst == GetFirstInstruction() ? nullptr : inst->Prev()->AsItem();
+    }
+    inst->Unlink();
 }
 
 /* static */
 BasicBlock *BasicBlock::Create(Graph *graph)
 {
-    auto *bb = new BasicBlock(graph->NewBBId(), graph);
+    auto *mem = graph->GetAllocator()->Alloc(sizeof(BasicBlock), alignof(BasicBlock));
+    auto *bb = new (mem) BasicBlock(graph->NewBBId(), graph);
     graph->InsertBasicBlock(bb);
     return bb;
 }
 
+Instruction *BasicBlock::GetFirstInstruction()
+{
+    if (instructions_.IsEmpty()) {
+        return nullptr;
+    }
+    return *instructions_.begin();
+}
+
 Instruction *BasicBlock::GetLastInstruction()
 {
     if (instructions_.IsEmpty()) {
@@ -40,14 +61,14 @@ Instruction *BasicBlock::GetLastInstruction()
     return *instructions_.rbegin();
 }
 
-std::vector<BasicBlock *> BasicBlock::GetSuccessors()
+BasicBlock::Successors BasicBlock::GetSuccessors() const
 {
-    std::vector<BasicBlock *> succ;
+    Successors succ;
     if (trueSuccessor_) {
-        succ.push_back(trueSuccessor_);
+        succ.PushBack(trueSuccessor_);
     }
     if (falseSuccessor_) {
-        succ.push_back(falseSuccessor_);
+        succ.PushBack(falseSuccessor_);
     }
     return succ;
 }
@@ -59,6 +80,7 @@ void BasicBlock::SetTrueSuccessor(BasicBlock *trueSucc)
     ASSERT(trueSucc != falseSuccessor_);
     trueSuccessor_ = trueSucc;
     trueSucc->AddPredeccessor(this);
+    graph_->InvalidateCfg();
 }
 
 void BasicBlock::SetFalseSuccessor(BasicBlock *falseSucc)
@@ -68,6 +90,7 @@ void BasicBlock::SetFalseSuccessor(BasicBlock *falseSucc)
     ASSERT(falseSucc != trueSuccessor_);
     falseSuccessor_ = falseSucc;
     falseSucc->AddPredeccessor(this);
+    graph_->InvalidateCfg();
 }
 
 void BasicBlock::UpdateControlFlow(BasicBlock *newTrueSucc, BasicBlock *newFalseSucc, BasicBlock *newSuccPredeccessor)
@@ -82,7 +105,7 @@ void BasicBlock::UpdateControlFlow(BasicBlock *newTrueSucc, BasicBlock *newFalse
     }
     if (falseSuccessor_ != nullptr) {
         falseSuccessor_->RemovePredecessor(this);
-        newSuccPredeccessor->SetFalseSuccessor(trueSuccessor_);
+        newSuccPredeccessor->SetFalseSuccessor(falseSuccessor_);
     }
     trueSuccessor_ = newTrueSucc;
     if (newTrueSucc) {
@@ -92,6 +115,66 @@ void BasicBlock::UpdateControlFlow(BasicBlock *newTrueSucc, BasicBlock *newFalse
     if (newFalseSucc) {
         newFalseSucc->AddPredeccessor(this);
     }
+    graph_->InvalidateCfg();
+}
+
+void BasicBlock::ReplaceSuccessor(BasicBlock *oldSucc, BasicBlock *newSucc)
+{
+    ASSERT(newSucc != nullptr);
+    ASSERT(newSucc != trueSuccessor_ && newSucc != falseSuccessor_);
+    if (trueSuccessor_ == oldSucc) {
+        trueSuccessor_ = newSucc;
+    } else {
+        ASSERT(falseSuccessor_ == oldSucc);
+        falseSuccessor_ = newSucc;
+    }
+    oldSucc->RemovePredecessor(this);
+    newSucc->AddPredeccessor(this);
+    graph_->InvalidateCfg();
+}
+
+void BasicBlock::DetachFromSuccessors()
+{
+    for (auto *succ : GetSuccessors()) {
+        // both successors may be the same block
+        if (succ->predecessors_.count(this) != 0) {
+            succ->RemoveIncomingBlock(this);
+        }
+    }
+    trueSuccessor_ = nullptr;
+    falseSuccessor_ = nullptr;
+    graph_->InvalidateCfg();
+}
+
+void BasicBlock::RemoveSuccessor(size_t idx)
+{
+    auto *succ = GetSuccessor(idx);
+    auto *otherSucc = GetSuccessor(1 - idx);
+    ASSERT(succ != nullptr);
+    if (succ != otherSucc) {
+        succ->RemoveIncomingBlock(this);
+    }
+    trueSuccessor_ = otherSucc;
+    falseSuccessor_ = nullptr;
+    graph_->InvalidateCfg();
+}
+
+void BasicBlock::RemoveIncomingBlock(BasicBlock *pred)
+{
+    RemovePredecessor(pred);
+    IterateOverInstructions([pred](Instruction *inst) {
+        // phis are placed at the beginning of the block
+        if (inst->GetOpcode() != Opcode::PHI) {
+            return true;
+        }
+        auto *phi = inst->As<PhiInst>();
+        for (auto idx = phi->GetInputs().Size(); idx > 0; --idx) {
+            if (phi->GetIncomingBlock(idx - 1) == pred) {
+                phi->RemoveDependency(idx - 1);
+            }
+        }
+        return false;
+    });
 }
 
 void BasicBlock::RemovePredecessor(BasicBlock *oldPredecc)
@@ -113,7 +196,7 @@ BasicBlock::~BasicBlock()
 {
     while (instructions_.NonEmpty()) {
         auto *inst = instructions_.PopFront();
-        delete inst;
+        inst->~Instruction();
     }
 }
 
@@ -133,6 +216,12 @@ void BasicBlock::AddDominatee(BasicBlock *dominatee)
     immDominatees_.push_back(dominatee);
 }
 
+void BasicBlock::ResetDominatorInfo()
+{
+    dominator_ = nullptr;
+    immDominatees_.clear();
+}
+
 const std::deque<BasicBlock *> &BasicBlock::GetImmediateDominatees() const
 {
     return immDominatees_;
@@ -149,6 +238,47 @@ void BasicBlock::IterateOverInstructions(InterruptibleVisitor visitor)
     }
 }
 
+bool BasicBlock::IsInstructionBefore(Instruction *inst1, Instruction *inst2)
+{
+    ASSERT(inst1->GetBasicBlock() == this && inst2->GetBasicBlock() == this);
+    if (!instOrdersValid_) {
+        RenumberInstructions();
+    }
+    return inst1->GetOrder() < inst2->GetOrder();
+}
+
+void BasicBlock::UpdateInstructionOrder(Instruction *inst)
+{
+    ASSERT(inst->GetBasicBlock() == this);
+    if (!instOrdersValid_) {
+        return;
+    }
+    uint32_t prevOrder = inst == GetFirstInstruction() ? 0 : inst->Prev()->AsItem()->GetOrder();
+    if (inst == GetLastInstruction()) {
+        if (prevOrder <= UINT32_MAX - InstOrderGap) {
+            inst->SetOrder(prevOrder + InstOrderGap);
+            return;
+        }
+    } else {
+        uint32_t nextOrder = inst->Next()->AsItem()->GetOrder();
+        if (nextOrder - prevOrder > 1) {
+            inst->SetOrder(prevOrder + (nextOrder - prevOrder) / 2);
+            return;
+        }
+    }
+    instOrdersValid_ = false;
+}
+
+void BasicBlock::RenumberInstructions()
+{
+    uint32_t order = 0;
+    for (auto *inst : instructions_) {
+        order += InstOrderGap;
+        inst->SetOrder(order);
+    }
+    instOrdersValid_ = true;
+}
+
 size_t BasicBlock::GetAliveInstructionCount()
 {
     return instructions_.Size();
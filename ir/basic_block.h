@@ -5,6 +5,7 @@
 #include "ir/marker.h"
 #include "utils/intrusive_list.h"
 #include "utils/macros.h"
+#include "utils/small_vector.h"
 
 #include <cstdint>
 #include <set>
@@ -25,6 +26,8 @@ public:
     ~BasicBlock();
 
     using Predecessors = std::set<BasicBlock *>;
+    static constexpr size_t MaxSuccessorsCount = 2;
+    using Successors = utils::SmallVector<BasicBlock *, MaxSuccessorsCount>;
     using InterruptibleVisitor = std::function<bool(Instruction *)>;
 
     Id GetId() const
@@ -53,6 +56,17 @@ public:
 
     void UpdateControlFlow(BasicBlock *newTrueSucc, BasicBlock *newFalseSucc, BasicBlock *newSuccPredeccessor);
 
+    // Redirects the edge to oldSucc to newSucc. Phis of oldSucc keep inputs incoming from this block, the caller
+    // updates them
+    void ReplaceSuccessor(BasicBlock *oldSucc, BasicBlock *newSucc);
+
+    // Removes this block from predecessors and phis of its successors and resets successors
+    void DetachFromSuccessors();
+
+    // Removes the edge to the successor with index idx, 0 is the true successor. The remaining successor becomes
+    // the true one
+    void RemoveSuccessor(size_t idx);
+
     BasicBlock *GetTrueSuccessor() const
     {
         return trueSuccessor_;
@@ -65,17 +79,17 @@ public:
 
     void Mark(Marker marker)
     {
-        marker_.Mark(marker);
+        markers_.Mark(marker);
     }
 
     void Unmark(Marker marker)
     {
-        marker_.Unmark(marker);
+        markers_.Unmark(marker);
     }
 
-    bool IsMarked(Marker marker)
+    bool IsMarked(Marker marker) const
     {
-        return marker_.IsMarked(marker);
+        return markers_.IsMarked(marker);
     }
 
     void SetDfsOrder(uint32_t dfsOrder)
@@ -88,7 +102,15 @@ public:
         return dfsOrder_;
     }
 
-    std::vector<BasicBlock *> GetSuccessors();
+    // Successor by index, 0 is the true successor and 1 is the false one. Returns nullptr if there is no such successor
+    BasicBlock *GetSuccessor(size_t idx) const
+    {
+        ASSERT(idx < MaxSuccessorsCount);
+        return idx == 0 ? trueSuccessor_ : falseSuccessor_;
+    }
+
+    // Existing successors, kept inline without heap allocation
+    Successors GetSuccessors() const;
 
     static BasicBlock *Create(Graph *graph);
 
@@ -96,8 +118,21 @@ public:
 
     void InsertPhiInst(Instruction *inst);
 
+    // Unlinks the phi keeping the insertion point of new phis valid
+    void RemovePhiInst(Instruction *inst);
+
+    Instruction *GetFirstInstruction();
+
     Instruction *GetLastInstruction();
 
+    // Does inst1 precede inst2? Both instructions must belong to this block
+    // Complexity: O(1) while the block is not modified, instructions are renumbered lazily otherwise
+    bool IsInstructionBefore(Instruction *inst1, Instruction *inst2);
+
+    // Keeps instruction orders valid after inst was linked into this block, renumbering is postponed
+    // until the next query if there is no gap left around inst
+    void UpdateInstructionOrder(Instruction *inst);
+
     void Dump(std::stringstream &ss) const;
 
     void SetDominator(BasicBlock *dominator);
@@ -106,6 +141,8 @@ public:
 
     void AddDominatee(BasicBlock *dominatee);
 
+    void ResetDominatorInfo();
+
     const std::deque<BasicBlock *> &GetImmediateDominatees() const;
 
     void IterateOverInstructions(InterruptibleVisitor visitor);
@@ -117,6 +154,14 @@ private:
 
     void RemovePredecessor(BasicBlock *oldPredecc);
 
+    // Removes the predecessor together with phi inputs which come from it
+    void RemoveIncomingBlock(BasicBlock *pred);
+
+    void RenumberInstructions();
+
+    // Distance between orders of neighbour instructions after renumbering
+    static constexpr uint32_t InstOrderGap = 16;
+
     Id id_;
     Graph *graph_;
     utils::IntrusiveList<Instruction> instructions_;
@@ -124,9 +169,10 @@ private:
     BasicBlock *trueSuccessor_ {nullptr};
     BasicBlock *falseSuccessor_ {nullptr};
     Instruction *lastPhiInst_ {nullptr};
+    bool instOrdersValid_ {false};
 
     // analysis
-    Marker marker_ {};
+    MarkerSet markers_ {};
     uint32_t dfsOrder_ {0};
     BasicBlock *dominator_ {nullptr};
     std::deque<BasicBlock *> immDominatees_;
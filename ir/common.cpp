@@ -147,4 +147,59 @@ bool operator<=(ResultType resType1, ResultType resType2)
     return t1 <= t2;
 }
 
+uint32_t GetResultTypeBits(ResultType resType)
+{
+    switch (resType) {
+        case ResultType::BOOL:
+            return 1U;
+        case ResultType::S8:
+        case ResultType::U8:
+            return 8U;
+        case ResultType::S16:
+        case ResultType::U16:
+            return 16U;
+        case ResultType::S32:
+        case ResultType::U32:
+            return 32U;
+        case ResultType::S64:
+        case ResultType::U64:
+            return 64U;
+        default:
+            UNREACHABLE();
+    }
+}
+
+bool IsUnsignedResultType(ResultType resType)
+{
+    switch (resType) {
+        case ResultType::BOOL:
+        case ResultType::U8:
+        case ResultType::U16:
+        case ResultType::U32:
+        case ResultType::U64:
+            return true;
+        case ResultType::S8:
+        case ResultType::S16:
+        case ResultType::S32:
+        case ResultType::S64:
+            return false;
+        default:
+            UNREACHABLE();
+    }
+}
+
+int64_t WrapToResultType(ResultType resType, int64_t value)
+{
+    auto bits = GetResultTypeBits(resType);
+    if (bits == 64U) {
+        return value;
+    }
+    auto mask = (uint64_t {1} << bits) - 1U;
+    auto lowBits = static_cast<uint64_t>(value) & mask;
+    if (!IsUnsignedResultType(resType) && (lowBits >> (bits - 1U)) != 0) {
+        lowBits |= ~mask;
+    }
+    return static_cast<int64_t>(lowBits);
+}
+
 }  // namespace compiler::ir
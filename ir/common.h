@@ -70,6 +70,15 @@ ResultType CombineResultType(const Instruction *op1, const Instruction *op2);
 
 bool operator<=(ResultType resType1, ResultType resType2);
 
+// Width of integer and bool types in bits
+uint32_t GetResultTypeBits(ResultType resType);
+
+// Bool is compared as unsigned value
+bool IsUnsignedResultType(ResultType resType);
+
+// Value wrapped around to the type width: sign extended for signed types and zero extended for unsigned ones
+int64_t WrapToResultType(ResultType resType, int64_t value);
+
 }  // namespace compiler::ir
 
 #endif
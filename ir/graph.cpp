@@ -2,12 +2,34 @@
 #include "ir/basic_block.h"
 #include "ir/call_graph.h"
 #include "ir/common.h"
+#include "ir/instruction.h"
+
+#include <algorithm>
+#include <utility>
 
 namespace compiler::ir {
 
 void Graph::InsertBasicBlock(BasicBlock *bb)
 {
     basicBlocks_.PushBack(bb);
+    InvalidateCfg();
+}
+
+void Graph::RemoveBasicBlocks(const std::vector<BasicBlock *> &blocks)
+{
+    if (blocks.empty()) {
+        return;
+    }
+    // removed blocks may be successors of each other, so they are destroyed after all of them are detached
+    for (auto *bb : blocks) {
+        ASSERT(bb != GetStartBlock());
+        bb->DetachFromSuccessors();
+    }
+    for (auto *bb : blocks) {
+        bb->Unlink();
+        bb->~BasicBlock();
+    }
+    InvalidateCfg();
 }
 
 void Graph::Dump(std::stringstream &ss) const
@@ -32,18 +54,91 @@ size_t Graph::GetBlocksCount() const
 
 Marker Graph::NewMarker()
 {
-    // markers are expired
-    ASSERT(currentMarker_ != 0);
-    auto marker = Marker(currentMarker_);
-    currentMarker_ <<= 1ULL;
-    return marker;
+    size_t slot = 0;
+    while (slot < Marker::MaxMarkersCount && (usedMarkerSlots_ & (1U << slot)) != 0) {
+        ++slot;
+    }
+    // too many markers are alive
+    ASSERT(slot < Marker::MaxMarkersCount);
+    usedMarkerSlots_ |= 1U << slot;
+    return Marker(++markerEpoch_, slot);
+}
+
+void Graph::ReleaseMarker(Marker marker)
+{
+    ASSERT(!marker.IsEmpty());
+    ASSERT((usedMarkerSlots_ & (1U << marker.GetSlot())) != 0);
+    usedMarkerSlots_ &= ~(1U << marker.GetSlot());
 }
 
 Graph::~Graph()
 {
     while (basicBlocks_.NonEmpty()) {
         auto *bb = basicBlocks_.PopFront();
-        delete bb;
+        bb->~BasicBlock();
+    }
+    // memory of blocks and instructions is released by allocator_ at once
+}
+
+const std::vector<BasicBlock *> &Graph::GetRpoBlocks()
+{
+    if (rpoCfgVersion_ != cfgVersion_) {
+        ComputeRpoBlocks();
+        rpoCfgVersion_ = cfgVersion_;
+    }
+    return rpoBlocks_;
+}
+
+void Graph::ComputeRpoBlocks()
+{
+    rpoBlocks_.clear();
+    auto *startBB = GetStartBlock();
+    if (startBB == nullptr) {
+        return;
+    }
+
+    // block ids are dense, so visited blocks are tracked without markers
+    std::vector<bool> visited(currentBBId_, false);
+    // explicit stack of (block, index of the next successor to visit)
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    visited[startBB->GetId()] = true;
+    stack.emplace_back(startBB, 0);
+    while (!stack.empty()) {
+        auto &[bb, succIdx] = stack.back();
+        if (succIdx == BasicBlock::MaxSuccessorsCount) {
+            rpoBlocks_.push_back(bb);
+            stack.pop_back();
+            continue;
+        }
+        auto *succ = bb->GetSuccessor(succIdx++);
+        if (succ != nullptr && !visited[succ->GetId()]) {
+            visited[succ->GetId()] = true;
+            stack.emplace_back(succ, 0);
+        }
+    }
+    std::reverse(rpoBlocks_.begin(), rpoBlocks_.end());
+}
+
+AssignInst *Graph::FindConstant(ResultType type, int64_t value) const
+{
+    auto constIt = constants_.find(ConstantKey {type, value});
+    return constIt == constants_.end() ? nullptr : constIt->second;
+}
+
+void Graph::RegisterConstant(AssignInst *constInst)
+{
+    ASSERT(constInst->GetOpcode() == Opcode::CONSTANT);
+    ASSERT(constInst->GetBasicBlock() == GetStartBlock());
+    [[maybe_unused]] auto inserted =
+        constants_.insert({ConstantKey {constInst->GetResultType(), constInst->GetValue()}, constInst}).second;
+    ASSERT(inserted);
+}
+
+void Graph::UnregisterConstant(AssignInst *constInst)
+{
+    auto constIt = constants_.find(ConstantKey {constInst->GetResultType(), constInst->GetValue()});
+    if (constIt != constants_.end() && constIt->second == constInst) {
+        constants_.erase(constIt);
     }
 }
 
@@ -4,17 +4,27 @@
 #include "ir/id.h"
 #include "ir/marker.h"
 #include "ir/common.h"
+#include "utils/arena_allocator.h"
 #include "utils/intrusive_list.h"
 #include "utils/macros.h"
 
 #include <cstdint>
 #include <sstream>
 #include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace compiler {
+class CompilerStatistics;
+}  // namespace compiler
 
 namespace compiler::ir {
 
 class BasicBlock;
 class CallGraph;
+class AssignInst;
 
 class Graph {
 public:
@@ -26,7 +36,7 @@ public:
     NO_MOVE_OPERATOR(Graph);
     ~Graph();
 
-    explicit Graph(CallGraph *callGraph, std::string_view methodName) : callGraph_(callGraph)
+    explicit Graph(CallGraph *callGraph, std::string_view methodName) : callGraph_(callGraph), methodName_(methodName)
     {
         LinkToCallGraph(methodName);
     }
@@ -36,20 +46,62 @@ public:
         return currentInstId_++;
     }
 
+    // Instruction ids are dense, every id of the graph is below the bound
+    Id GetInstIdsBound() const
+    {
+        return currentInstId_;
+    }
+
     Id NewBBId()
     {
         return currentBBId_++;
     }
 
+    // Block ids are dense, every id of the graph is below the bound
+    Id GetBBIdsBound() const
+    {
+        return currentBBId_;
+    }
+
     MethodId GetMethodId() const
     {
         return id_;
     }
 
+    // Empty for graphs which are not linked to a call graph
+    std::string_view GetMethodName() const
+    {
+        return methodName_;
+    }
+
+    // Passes and analyses of the graph record their statistics into the collector, nullptr disables the collection
+    void SetStatistics(CompilerStatistics *statistics)
+    {
+        statistics_ = statistics;
+    }
+
+    CompilerStatistics *GetStatistics() const
+    {
+        return statistics_;
+    }
+
+    // Complexity: O(1), at most Marker::MaxMarkersCount markers may be alive at the same time
     Marker NewMarker();
 
+    // Frees the slot of the marker, marks left by it are never observed by the next markers
+    void ReleaseMarker(Marker marker);
+
+    utils::ArenaAllocator *GetAllocator()
+    {
+        return &allocator_;
+    }
+
     void InsertBasicBlock(BasicBlock *bb);
 
+    // Unlinks the blocks from their successors and destroys them. Predecessors of the blocks and users of their values
+    // must be removed as well
+    void RemoveBasicBlocks(const std::vector<BasicBlock *> &blocks);
+
     void Dump(std::stringstream &ss) const;
 
     BasicBlock *GetStartBlock();
@@ -60,17 +112,92 @@ public:
 
     void IterateOverBlocks(const BlockVisitor &visitor);
 
+    // Must be called on every change of control flow: blocks insertion or successors update
+    void InvalidateCfg()
+    {
+        ++cfgVersion_;
+    }
+
+    uint64_t GetCfgVersion() const
+    {
+        return cfgVersion_;
+    }
+
+    // Reachable blocks in reverse post order. Order is cached and recomputed only after control flow has changed
+    const std::vector<BasicBlock *> &GetRpoBlocks();
+
+    // Constants placed in the start block dominate every instruction of the graph, so they are shared by all users.
+    // Returns nullptr if there is no such constant
+    AssignInst *FindConstant(ResultType type, int64_t value) const;
+
+    void RegisterConstant(AssignInst *constInst);
+
+    // Does nothing if constInst is not registered
+    void UnregisterConstant(AssignInst *constInst);
+
 private:
+    struct ConstantKey {
+        ResultType type;
+        int64_t value;
+
+        bool operator==(const ConstantKey &that) const
+        {
+            return type == that.type && value == that.value;
+        }
+    };
+
+    struct ConstantKeyHash {
+        size_t operator()(const ConstantKey &key) const
+        {
+            return std::hash<int64_t> {}(key.value) * 31U + static_cast<size_t>(key.type);
+        }
+    };
+
     void LinkToCallGraph(std::string_view methodName);
 
+    void ComputeRpoBlocks();
+
     CallGraph *callGraph_;
+    std::string methodName_;
     MethodId id_ {0};
     Id currentBBId_ {0};
     Id currentInstId_ {0};
-    uint64_t currentMarker_ {1};
+    uint64_t markerEpoch_ {0};
+    // bit per marker slot which is in use
+    uint32_t usedMarkerSlots_ {0};
+    uint64_t cfgVersion_ {1};
+    // version of control flow which rpoBlocks_ were computed for
+    uint64_t rpoCfgVersion_ {0};
+    std::vector<BasicBlock *> rpoBlocks_;
+    std::unordered_map<ConstantKey, AssignInst *, ConstantKeyHash> constants_;
+    CompilerStatistics *statistics_ {nullptr};
+    // owns memory of all blocks and instructions of the graph
+    utils::ArenaAllocator allocator_;
     utils::IntrusiveList<BasicBlock> basicBlocks_;
 };
 
+// Holds a new marker of the graph until the end of the scope
+class MarkerHolder {
+public:
+    explicit MarkerHolder(Graph *graph) : graph_(graph), marker_(graph->NewMarker()) {}
+    NO_COPY_SEMANTIC(MarkerHolder);
+    NO_MOVE_SEMANTIC(MarkerHolder);
+
+    ~MarkerHolder()
+    {
+        graph_->ReleaseMarker(marker_);
+    }
+
+    Marker GetMarker() const
+    {
+        return marker_;
+    }
+
+private:
+    Graph *graph_;
+    Marker marker_;
+};
+
 }  // namespace compiler::ir
 
 #endif  // IR_GRAPH_H
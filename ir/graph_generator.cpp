@@ -0,0 +1,244 @@
+#include "ir/graph_generator.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/graph.h"
+#include "ir/instruction.h"
+#include "ir/ir_builder.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace compiler::ir {
+
+std::vector<std::unique_ptr<Graph>> GraphGenerator::GenerateMethods(CallGraph *callGraph)
+{
+    ASSERT(options_.methodsCount != 0);
+    std::vector<std::unique_ptr<Graph>> methods;
+    for (size_t idx = 0; idx < options_.methodsCount; ++idx) {
+        methods.push_back(std::make_unique<Graph>(callGraph, "method" + std::to_string(idx)));
+    }
+    for (size_t idx = 0; idx < methods.size(); ++idx) {
+        std::vector<MethodId> callees;
+        for (auto calleeIdx = idx + 1; calleeIdx < methods.size(); ++calleeIdx) {
+            callees.push_back(methods[calleeIdx]->GetMethodId());
+        }
+        GenerateMethod(methods[idx].get(), callees);
+    }
+    return methods;
+}
+
+void GraphGenerator::GenerateMethod(Graph *graph)
+{
+    GenerateMethod(graph, {});
+}
+
+void GraphGenerator::GenerateMethod(Graph *graph, const std::vector<MethodId> &callees)
+{
+    ASSERT(graph->GetBlocksCount() == 0);
+    auto irBuilder = IRBuilder {graph};
+    irBuilder_ = &irBuilder;
+    values_.clear();
+    params_.clear();
+    constants_.clear();
+    callees_ = callees;
+    callsLeft_ = callees.empty() ? 0 : options_.callsPerMethod;
+    blocksLeft_ = options_.blocksCount > 2 ? options_.blocksCount - 2 : 0;
+
+    // start block keeps only parameters and constants, so the method may be inlined
+    auto *startBB = BasicBlock::Create(graph);
+    irBuilder.SetInsertionPoint(startBB);
+    for (uint32_t idx = 0; idx < ParamsCount; ++idx) {
+        params_.push_back(irBuilder.CreateParam(ResultType::S32, idx));
+    }
+    for (auto value : {0, 1, 2, 10}) {
+        constants_.push_back(irBuilder.CreateConstInt(value));
+    }
+    values_.insert(values_.end(), params_.begin(), params_.end());
+    values_.insert(values_.end(), constants_.begin(), constants_.end());
+    auto *firstBB = BasicBlock::Create(graph);
+    irBuilder.CreateBr(firstBB);
+
+    auto *lastBB = GenerateSequence(firstBB, blocksLeft_, 0);
+    GenerateInstructions(lastBB);
+    while (callsLeft_ != 0) {
+        GenerateCall();
+    }
+    irBuilder.CreateRet(PickValue());
+    irBuilder_ = nullptr;
+}
+
+BasicBlock *GraphGenerator::GenerateSequence(BasicBlock *bb, size_t blocksBudget, size_t loopDepth)
+{
+    // region kinds need 3 new blocks at least
+    constexpr size_t RegionBlocks = 3;
+    auto stopAt = blocksLeft_ > blocksBudget ? blocksLeft_ - blocksBudget : 0;
+    while (blocksLeft_ > stopAt) {
+        auto budget = blocksLeft_ - stopAt;
+        if (budget >= RegionBlocks && loopDepth < options_.maxLoopDepth && Chance(options_.loopProbability)) {
+            bb = GenerateLoop(bb, budget - RegionBlocks, loopDepth);
+        } else if (budget >= RegionBlocks && Chance(options_.branchProbability)) {
+            bb = GenerateDiamond(bb, budget - RegionBlocks, loopDepth);
+        } else {
+            GenerateInstructions(bb);
+            auto *nextBB = BasicBlock::Create(bb->GetGraph());
+            --blocksLeft_;
+            irBuilder_->CreateBr(nextBB);
+            bb = nextBB;
+        }
+    }
+    return bb;
+}
+
+/**
+ *        bb
+ *       /  \
+ *   left    right   (nested sequences)
+ *       \  /
+ *       join        (phis of values from both arms)
+ */
+BasicBlock *GraphGenerator::GenerateDiamond(BasicBlock *bb, size_t blocksBudget, size_t loopDepth)
+{
+    auto *graph = bb->GetGraph();
+    GenerateInstructions(bb);
+    auto *cond = irBuilder_->CreateCmpLT(PickValue(), PickValue());
+    auto *left = BasicBlock::Create(graph);
+    auto *right = BasicBlock::Create(graph);
+    auto *join = BasicBlock::Create(graph);
+    blocksLeft_ -= 3;
+    irBuilder_->CreateCondBr(cond, left, right);
+
+    // values of an arm do not dominate the join, they are merged by phis
+    auto generateArm = [this, join, blocksBudget, loopDepth](BasicBlock *armBB) {
+        auto scopeSize = values_.size();
+        auto *armEnd = GenerateSequence(armBB, blocksBudget / 2, loopDepth);
+        GenerateInstructions(armEnd);
+        std::vector<Instruction *> phiValues;
+        for (size_t idx = 0; idx < options_.phisCount; ++idx) {
+            phiValues.push_back(PickValue());
+        }
+        irBuilder_->CreateBr(join);
+        values_.resize(scopeSize);
+        return std::make_pair(armEnd, std::move(phiValues));
+    };
+    auto [leftEnd, leftValues] = generateArm(left);
+    auto [rightEnd, rightValues] = generateArm(right);
+
+    irBuilder_->SetInsertionPoint(join);
+    for (size_t idx = 0; idx < options_.phisCount; ++idx) {
+        auto *phi = irBuilder_->CreatePhi(ResultType::S32);
+        phi->ResolveDependency(leftValues[idx], leftEnd);
+        phi->ResolveDependency(rightValues[idx], rightEnd);
+        values_.push_back(phi);
+    }
+    return join;
+}
+
+/**
+ *    preheader
+ *        |
+ *      header <---  (phis, exit condition)
+ *      /    \     |
+ *   exit    body --  (nested sequence)
+ */
+BasicBlock *GraphGenerator::GenerateLoop(BasicBlock *bb, size_t blocksBudget, size_t loopDepth)
+{
+    auto *graph = bb->GetGraph();
+    GenerateInstructions(bb);
+    auto *header = BasicBlock::Create(graph);
+    auto *body = BasicBlock::Create(graph);
+    auto *exit = BasicBlock::Create(graph);
+    blocksLeft_ -= 3;
+    irBuilder_->CreateBr(header);
+
+    // initial values are picked before any phi of the header becomes visible
+    std::vector<Instruction *> initValues;
+    for (size_t idx = 0; idx < std::max<size_t>(options_.phisCount, 1); ++idx) {
+        initValues.push_back(PickValue());
+    }
+    irBuilder_->SetInsertionPoint(header);
+    std::vector<PhiInst *> phis;
+    for (auto *initValue : initValues) {
+        auto *phi = irBuilder_->CreatePhi(ResultType::S32);
+        phi->ResolveDependency(initValue, bb);
+        phis.push_back(phi);
+    }
+    auto *cond = irBuilder_->CreateCmpLT(phis.front(), params_.front());
+    irBuilder_->CreateCondBr(cond, body, exit);
+    // header dominates both body and exit
+    values_.insert(values_.end(), phis.begin(), phis.end());
+
+    auto scopeSize = values_.size();
+    auto *latch = GenerateSequence(body, blocksBudget, loopDepth + 1);
+    GenerateInstructions(latch);
+    for (auto *phi : phis) {
+        phi->ResolveDependency(PickValue(), latch);
+    }
+    irBuilder_->CreateBr(header);
+    values_.resize(scopeSize);
+
+    irBuilder_->SetInsertionPoint(exit);
+    return exit;
+}
+
+void GraphGenerator::GenerateInstructions(BasicBlock *bb)
+{
+    irBuilder_->SetInsertionPoint(bb);
+    for (size_t idx = 0; idx < options_.instsPerBlock; ++idx) {
+        auto *op1 = PickValue();
+        auto *op2 = PickValue();
+        switch (Random(4)) {
+            case 0:
+                values_.push_back(irBuilder_->CreateAdd(op1, op2));
+                break;
+            case 1:
+                values_.push_back(irBuilder_->CreateMul(op1, op2));
+                break;
+            case 2:
+                // small shift amounts keep folded constants in range
+                values_.push_back(irBuilder_->CreateShl(op1, constants_[Random(3)]));
+                break;
+            default:
+                values_.push_back(irBuilder_->CreateXor(op1, op2));
+                break;
+        }
+    }
+    if (Chance(options_.memoryProbability)) {
+        GenerateMemoryAccesses();
+    }
+    // calls are spread over the method, the rest is emitted in the last block
+    if (callsLeft_ != 0 && Chance(static_cast<double>(options_.callsPerMethod) / (options_.blocksCount + 1))) {
+        GenerateCall();
+    }
+}
+
+// Store and load of the same element, the second pair of checks is redundant
+void GraphGenerator::GenerateMemoryAccesses()
+{
+    auto *mem = irBuilder_->CreateMemory(ResultType::S32, constants_.back());
+    auto *idx = constants_[Random(constants_.size() - 1)];
+    irBuilder_->CreateNullCheck(mem);
+    irBuilder_->CreateBoundCheck(mem, idx);
+    irBuilder_->CreateStore(mem, idx, PickValue());
+    irBuilder_->CreateNullCheck(mem);
+    irBuilder_->CreateBoundCheck(mem, idx);
+    values_.push_back(irBuilder_->CreateLoad(mem, idx));
+}
+
+void GraphGenerator::GenerateCall()
+{
+    ASSERT(callsLeft_ != 0 && !callees_.empty());
+    --callsLeft_;
+    auto calleeId = callees_[Random(callees_.size())];
+    auto *arg1 = PickValue();
+    auto *arg2 = PickValue();
+    values_.push_back(irBuilder_->CreateCallStatic(calleeId, ResultType::S32, {arg1, arg2}));
+}
+
+Instruction *GraphGenerator::PickValue()
+{
+    ASSERT(!values_.empty());
+    return values_[Random(values_.size())];
+}
+
+}  // namespace compiler::ir
@@ -0,0 +1,107 @@
+#ifndef IR_GRAPH_GENERATOR_H
+#define IR_GRAPH_GENERATOR_H
+
+#include "ir/common.h"
+#include "utils/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace compiler::ir {
+
+class Graph;
+class CallGraph;
+class BasicBlock;
+class Instruction;
+class IRBuilder;
+
+// Shape of generated methods. Probabilities are checked once per generated region or block
+struct GeneratorOptions {
+    uint64_t seed {0};
+    // approximate number of blocks in every method
+    size_t blocksCount {32};
+    size_t instsPerBlock {4};
+    size_t maxLoopDepth {2};
+    // probability that the next region is an if-else diamond
+    double branchProbability {0.3};
+    // probability that the next region is a loop
+    double loopProbability {0.2};
+    // phis created in every join and loop header
+    size_t phisCount {1};
+    // probability that a block allocates memory and accesses it under null and bound checks
+    double memoryProbability {0.3};
+    size_t methodsCount {1};
+    // calls emitted by every method, each of them calls a method with bigger index
+    size_t callsPerMethod {0};
+};
+
+// Builds valid SSA graphs through IRBuilder. Generation is deterministic for the same options
+class GraphGenerator {
+public:
+    // Every method takes this number of s32 parameters and returns s32
+    static constexpr uint32_t ParamsCount = 2;
+
+    explicit GraphGenerator(const GeneratorOptions &options) : options_(options), random_(options.seed) {}
+    NO_COPY_SEMANTIC(GraphGenerator);
+    NO_MOVE_SEMANTIC(GraphGenerator);
+    ~GraphGenerator() = default;
+
+    /**
+     * Generates options.methodsCount methods linked into callGraph. Call graph is acyclic: every method calls
+     * only methods with bigger indices
+     * @return methods, the first one is the root of the call graph
+     */
+    std::vector<std::unique_ptr<Graph>> GenerateMethods(CallGraph *callGraph);
+
+    // Generates body of a single method into an empty graph, calls are not emitted
+    void GenerateMethod(Graph *graph);
+
+private:
+    void GenerateMethod(Graph *graph, const std::vector<MethodId> &callees);
+
+    // Emits regions until the blocks budget is exhausted. Returns the block where control flow continues
+    BasicBlock *GenerateSequence(BasicBlock *bb, size_t blocksBudget, size_t loopDepth);
+
+    BasicBlock *GenerateDiamond(BasicBlock *bb, size_t blocksBudget, size_t loopDepth);
+
+    BasicBlock *GenerateLoop(BasicBlock *bb, size_t blocksBudget, size_t loopDepth);
+
+    void GenerateInstructions(BasicBlock *bb);
+
+    void GenerateMemoryAccesses();
+
+    void GenerateCall();
+
+    Instruction *PickValue();
+
+    size_t Random(size_t bound)
+    {
+        ASSERT(bound != 0);
+        return std::uniform_int_distribution<size_t>(0, bound - 1)(random_);
+    }
+
+    bool Chance(double probability)
+    {
+        return std::bernoulli_distribution(probability)(random_);
+    }
+
+    GeneratorOptions options_;
+    std::mt19937_64 random_;
+
+    // state of the method being generated
+    IRBuilder *irBuilder_ {nullptr};
+    // s32 values which dominate the insertion point
+    std::vector<Instruction *> values_;
+    std::vector<Instruction *> params_;
+    std::vector<Instruction *> constants_;
+    std::vector<MethodId> callees_;
+    size_t callsLeft_ {0};
+    size_t blocksLeft_ {0};
+};
+
+}  // namespace compiler::ir
+
+#endif  // IR_GRAPH_GENERATOR_H
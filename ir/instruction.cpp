@@ -1,7 +1,9 @@
 #include "ir/instruction.h"
 #include "ir/common.h"
 #include "ir/basic_block.h"
+#include "ir/graph.h"
 
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -9,9 +11,9 @@ namespace compiler::ir {
 
 namespace {
 
-void DumpInputs(std::stringstream &ss, const Instruction::Inputs &inputs)
+void DumpInputs(std::stringstream &ss, Instruction::InputsRange inputs)
 {
-    for (auto inputIt = inputs.cbegin(), inputEnd = inputs.cend(); inputIt != inputEnd; ++inputIt) {
+    for (auto inputIt = inputs.begin(), inputEnd = inputs.end(); inputIt != inputEnd; ++inputIt) {
         ss << 'v' << (*inputIt)->GetInstId().GetId();
         if (std::next(inputIt) != inputEnd) {
             ss << ", ";
@@ -20,9 +22,9 @@ void DumpInputs(std::stringstream &ss, const Instruction::Inputs &inputs)
 }
 
 template <typename InstType, typename... InstArgs>
-Instruction *CreateInstruction(InstArgs... args)
+Instruction *CreateInstruction(BasicBlock *bb, InstArgs... args)
 {
-    auto *inst = new InstType {std::forward<InstArgs>(args)...};
+    auto *inst = bb->GetGraph()->GetAllocator()->New<InstType>(bb, std::forward<InstArgs>(args)...);
     if (inst->GetOpcode() != Opcode::PHI) {
         inst->GetBasicBlock()->InsertInstBack(inst);
     } else {
@@ -38,40 +40,59 @@ void Instruction::Dump(std::stringstream &ss) const
     ss << instId_ << '.' << resType_ << ' ' << op_ << ' ';
 }
 
+void Instruction::ReplaceUsersWith(Instruction *newInst)
+{
+    ASSERT(newInst != this);
+    while (users_.NonEmpty()) {
+        // relinks the use into users of newInst
+        users_.begin()->Set(newInst);
+    }
+}
+
+void Instruction::InsertInstBefore(Instruction *insertionPoint)
+{
+    ASSERT(insertionPoint->GetBasicBlock() == ownBB_);
+    LinkBefore(insertionPoint);
+    ownBB_->UpdateInstructionOrder(this);
+}
+
+void Instruction::MoveBefore(Instruction *insertionPoint)
+{
+    ASSERT(op_ != Opcode::PHI);
+    ASSERT(insertionPoint != this);
+    auto *newBB = insertionPoint->GetBasicBlock();
+    if (op_ == Opcode::CONSTANT && newBB != newBB->GetGraph()->GetStartBlock()) {
+        newBB->GetGraph()->UnregisterConstant(As<AssignInst>());
+    }
+    Unlink();
+    ownBB_ = newBB;
+    LinkBefore(insertionPoint);
+    ownBB_->UpdateInstructionOrder(this);
+}
+
 /* static */
 void Instruction::UpdateUsersAndEliminate(Instruction *inst, Instruction *newInst)
 {
     ASSERT(inst != newInst);
     ASSERT(newInst != nullptr);
-
-    auto &users = inst->users_;
-    newInst->AddUsers(users);
-    for (auto *user : users) {
-        if (user->GetOpcode() == Opcode::PHI) {
-            user->As<PhiInst>()->UpdateDependencies(inst, newInst);
-        } else {
-            user->UpdateInputs(inst, newInst);
-        }
-    }
-    users.clear();
+    inst->ReplaceUsersWith(newInst);
     Instruction::Eliminate(inst);
 }
 
 /* static */
 void Instruction::Eliminate(Instruction *inst)
 {
-    ASSERT(inst->GetUsers().empty());
-    if (inst->GetOpcode() == Opcode::PHI) {
-        for (auto &[input, _] : inst->As<PhiInst>()->GetValueDependencies()) {
-            input->users_.erase(inst);
-        }
+    ASSERT(!inst->HasUsers());
+    if (inst->GetOpcode() == Opcode::CONSTANT) {
+        inst->GetBasicBlock()->GetGraph()->UnregisterConstant(inst->As<AssignInst>());
+    }
+    if (inst->GetOpcode() == Opcode::PHI && inst->IsLinked()) {
+        inst->GetBasicBlock()->RemovePhiInst(inst);
     } else {
-        for (auto *input : inst->GetInputs()) {
-            input->users_.erase(inst);
-        }
+        inst->Unlink();
     }
-    inst->Unlink();
-    delete inst;
+    // memory is owned by the graph allocator, inputs unlink themselves from users of their values
+    inst->~Instruction();
 }
 
 void Instruction::UpdateBasicBlock(BasicBlock *newBB)
@@ -79,29 +100,21 @@ void Instruction::UpdateBasicBlock(BasicBlock *newBB)
     ASSERT(ownBB_ != nullptr);
     ASSERT(newBB != nullptr);
     auto *oldBB = std::exchange(ownBB_, newBB);
-    for (auto *user : GetUsers()) {
-        if (user->GetOpcode() == ir::Opcode::PHI) {
-            user->As<ir::PhiInst>()->UpdateValueBasicBlock(this, oldBB, newBB);
-        }
+    if (op_ == Opcode::CONSTANT && newBB != newBB->GetGraph()->GetStartBlock()) {
+        // constant does not dominate the whole graph anymore
+        newBB->GetGraph()->UnregisterConstant(As<AssignInst>());
     }
-}
-
-void Instruction::UpdateInputs(Instruction *oldInput, Instruction *newInput)
-{
-    for (auto &input : inputs_) {
-        if (input == oldInput) {
-            input = newInput;
-            break;
+    for (auto *use : users_) {
+        auto *user = use->GetUser();
+        if (user->GetOpcode() == ir::Opcode::PHI) {
+            auto *phi = user->As<ir::PhiInst>();
+            if (phi->GetIncomingBlock(use->GetIndex()) == oldBB) {
+                phi->SetIncomingBlock(use->GetIndex(), newBB);
+            }
         }
     }
 }
 
-Instruction *Instruction::GetInput(size_t idx) const
-{
-    ASSERT(idx < inputs_.size());
-    return *std::next(inputs_.begin(), idx);
-}
-
 void AssignInst::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
@@ -116,8 +129,8 @@ Instruction *AssignInst::ShallowCopy(BasicBlock *newBB, InstId id) const
 void ArithmInst::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    auto &inputs = GetInputs();
-    ss << 'v' << inputs.front()->GetInstId().GetId() << ", v" << inputs.back()->GetInstId().GetId();
+    auto inputs = GetInputs();
+    ss << 'v' << inputs.Front()->GetInstId().GetId() << ", v" << inputs.Back()->GetInstId().GetId();
 }
 
 Instruction *ArithmInst::ShallowCopy(BasicBlock *newBB, InstId id) const
@@ -127,8 +140,8 @@ Instruction *ArithmInst::ShallowCopy(BasicBlock *newBB, InstId id) const
 
 std::pair<bool, bool> ArithmInst::CheckInputsAreConst()
 {
-    auto *op1 = GetInputs().front();
-    auto *op2 = GetInputs().back();
+    auto *op1 = GetInputs().Front();
+    auto *op2 = GetInputs().Back();
     return {op1->GetOpcode() == Opcode::CONSTANT, op2->GetOpcode() == Opcode::CONSTANT};
 }
 
@@ -136,8 +149,8 @@ void LogicInst::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
     ss << flags_ << ' ';
-    auto &inputs = GetInputs();
-    ss << 'v' << inputs.front()->GetInstId().GetId() << ", v" << inputs.back()->GetInstId().GetId();
+    auto inputs = GetInputs();
+    ss << 'v' << inputs.Front()->GetInstId().GetId() << ", v" << inputs.Back()->GetInstId().GetId();
 }
 
 Instruction *LogicInst::ShallowCopy(BasicBlock *newBB, InstId id) const
@@ -153,7 +166,7 @@ void BranchInst::Dump(std::stringstream &ss) const
         ss << "BB." << bb->GetTrueSuccessor()->GetId();
     } else {
         ASSERT(GetOpcode() == Opcode::COND_BRANCH);
-        ss << 'v' << GetInputs().front()->GetInstId().GetId() << ", BB." << bb->GetTrueSuccessor()->GetId() << ", BB."
+        ss << 'v' << GetInputs().Front()->GetInstId().GetId() << ", BB." << bb->GetTrueSuccessor()->GetId() << ", BB."
            << bb->GetFalseSuccessor()->GetId();
     }
 }
@@ -181,15 +194,9 @@ Instruction *ReturnInst::ShallowCopy(BasicBlock *newBB, InstId id) const
 void PhiInst::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    for (auto valueDepIt = valueDeps_.cbegin(); valueDepIt != valueDeps_.cend(); ++valueDepIt) {
-        auto &[inst, bbs] = *valueDepIt;
-        for (auto bbIt = bbs.cbegin(); bbIt != bbs.cend(); ++bbIt) {
-            ss << 'v' << inst->GetInstId().GetId() << ":BB." << (*bbIt)->GetId();
-            if (std::next(bbIt) != bbs.cend()) {
-                ss << ", ";
-            }
-        }
-        if (std::next(valueDepIt) != valueDeps_.cend()) {
+    for (size_t idx = 0; idx < incomingBlocks_.Size(); ++idx) {
+        ss << 'v' << GetInput(idx)->GetInstId().GetId() << ":BB." << incomingBlocks_[idx]->GetId();
+        if (idx + 1 != incomingBlocks_.Size()) {
             ss << ", ";
         }
     }
@@ -203,35 +210,42 @@ Instruction *PhiInst::ShallowCopy(BasicBlock *newBB, InstId id) const
 void PhiInst::ResolveDependency(Instruction *value, BasicBlock *bb)
 {
     ASSERT(value->GetResultType() == GetResultType());
-    valueDeps_[value].push_back(bb);
-    value->AddUsers(this);
+    AddInputs(value);
+    incomingBlocks_.PushBack(bb);
 }
 
-void PhiInst::UpdateDependencies(Instruction *oldValue, Instruction *newValue)
+void PhiInst::UpdateValueBasicBlock(Instruction *value, BasicBlock *oldBB, BasicBlock *newBB)
 {
-    auto node = valueDeps_.extract(oldValue);
-    ASSERT(!node.empty());
-    node.key() = newValue;
-    auto insertRes = valueDeps_.insert(std::move(node));
-    if (!insertRes.inserted) {
-        valueDeps_[newValue].merge(std::move(insertRes.node.mapped()));
+    for (size_t idx = 0; idx < incomingBlocks_.Size(); ++idx) {
+        if (GetInput(idx) == value && incomingBlocks_[idx] == oldBB) {
+            incomingBlocks_[idx] = newBB;
+        }
     }
 }
 
-void PhiInst::UpdateValueBasicBlock(Instruction *value, BasicBlock *oldBB, BasicBlock *newBB)
+void PhiInst::RemoveDependency(size_t idx)
 {
-    auto valueDepIt = valueDeps_.find(value);
-    ASSERT(valueDepIt != valueDeps_.end());
-    for (auto &bb : valueDepIt->second) {
-        if (bb == oldBB) {
-            bb = newBB;
-        }
+    RemoveInput(idx);
+    incomingBlocks_.Erase(incomingBlocks_.begin() + idx);
+}
+
+bool PhiInst::HasOnlyOneDependency() const
+{
+    auto inputs = GetInputs();
+    if (inputs.IsEmpty()) {
+        return false;
     }
+    auto *value = inputs.Front();
+    return std::all_of(inputs.begin(), inputs.end(), [value](Instruction *input) { return input == value; });
 }
 
-bool PhiInst::HasOnlyOneDependency()
+PhiInst::ValueDependencies PhiInst::GetValueDependencies() const
 {
-    return valueDeps_.size() == 1;
+    ValueDependencies valueDeps;
+    for (size_t idx = 0; idx < incomingBlocks_.Size(); ++idx) {
+        valueDeps[GetInput(idx)].push_back(incomingBlocks_[idx]);
+    }
+    return valueDeps;
 }
 
 void MemoryInst::Dump(std::stringstream &ss) const
@@ -5,10 +5,14 @@
 #include "ir/common.h"
 #include "utils/macros.h"
 #include "utils/intrusive_list.h"
+#include "utils/small_vector.h"
 
+#include <algorithm>
+#include <iterator>
 #include <list>
 #include <set>
 #include <sstream>
+#include <utility>
 #include <unordered_map>
 #include <initializer_list>
 
@@ -17,19 +21,241 @@ namespace compiler::ir {
 class BasicBlock;
 class Instruction;
 
+// Operand slot of an instruction. Every use is linked into the list of users of the value it refers to,
+// so def-use and use-def chains are updated in O(1) without extra allocations
+class Use : public utils::IntrusiveListNode<Use> {
+public:
+    using ListNode = utils::IntrusiveListNode<Use>;
+
+    Use(Instruction *user, Instruction *value) : ListNode(), user_(user)
+    {
+        Set(value);
+    }
+
+    NO_COPY_SEMANTIC(Use);
+
+    // Moved use takes the place of `that` in the users list, so operand storage may be relocated
+    Use(Use &&that) : ListNode(), user_(that.user_), value_(std::exchange(that.value_, nullptr))
+    {
+        TakeListPosition(&that);
+    }
+
+    Use &operator=(Use &&that)
+    {
+        if (this != &that) {
+            Unlink();
+            user_ = that.user_;
+            value_ = std::exchange(that.value_, nullptr);
+            TakeListPosition(&that);
+        }
+        return *this;
+    }
+
+    ~Use()
+    {
+        Unlink();
+    }
+
+    Instruction *GetUser() const
+    {
+        return user_;
+    }
+
+    Instruction *GetValue() const
+    {
+        return value_;
+    }
+
+    // Position of this use among inputs of its user
+    size_t GetIndex() const;
+
+    inline void Set(Instruction *value);
+
+private:
+    void TakeListPosition(Use *that)
+    {
+        if (!that->IsLinked()) {
+            return;
+        }
+        prev_ = that->prev_;
+        next_ = that->next_;
+        prev_->next_ = this;
+        next_->prev_ = this;
+        that->prev_ = that->next_ = nullptr;
+    }
+
+    Instruction *user_;
+    Instruction *value_ {nullptr};
+};
+
 class Instruction : public utils::IntrusiveListNode<Instruction> {
 public:
-    using Inputs = std::list<Instruction *>;
+    // Arithmetic, logic, memory and check instructions fit inline, calls and phis may spill
+    static constexpr size_t InlineInputsCount = 3;
+    using Inputs = utils::SmallVector<Instruction *, InlineInputsCount>;
     using Users = std::set<Instruction *>;
+    using Uses = utils::IntrusiveList<Use>;
     using ListNode = utils::IntrusiveListNode<Instruction>;
 
+    // Read-only view of operands which yields used instructions
+    class InputsRange {
+    public:
+        class Iterator {
+        public:
+            using value_type = Instruction *;
+            using pointer = value_type *;
+            using reference = value_type;
+            using difference_type = ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            explicit Iterator(const Use *use) : use_(use) {}
+
+            Iterator &operator++()
+            {
+                ++use_;
+                return *this;
+            }
+
+            bool operator==(const Iterator &that) const
+            {
+                return use_ == that.use_;
+            }
+
+            bool operator!=(const Iterator &that) const
+            {
+                return !(*this == that);
+            }
+
+            Instruction *operator*() const
+            {
+                return use_->GetValue();
+            }
+
+        private:
+            const Use *use_;
+        };
+
+        InputsRange(const Use *begin, const Use *end) : begin_(begin), end_(end) {}
+
+        Iterator begin() const
+        {
+            return Iterator(begin_);
+        }
+
+        Iterator end() const
+        {
+            return Iterator(end_);
+        }
+
+        size_t Size() const
+        {
+            return end_ - begin_;
+        }
+
+        bool IsEmpty() const
+        {
+            return begin_ == end_;
+        }
+
+        Instruction *operator[](size_t idx) const
+        {
+            ASSERT(idx < Size());
+            return begin_[idx].GetValue();
+        }
+
+        Instruction *Front() const
+        {
+            return (*this)[0];
+        }
+
+        Instruction *Back() const
+        {
+            return (*this)[Size() - 1];
+        }
+
+        bool operator==(const Inputs &that) const
+        {
+            return std::equal(begin(), end(), that.begin(), that.end());
+        }
+
+    private:
+        const Use *begin_;
+        const Use *end_;
+    };
+
+    // Read-only view of the users list which yields user instructions, one per use
+    class UsersRange {
+    public:
+        class Iterator {
+        public:
+            using value_type = Instruction *;
+            using pointer = value_type *;
+            using reference = value_type;
+            using difference_type = ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            explicit Iterator(Uses::ConstIterator it) : it_(it) {}
+
+            Iterator &operator++()
+            {
+                ++it_;
+                return *this;
+            }
+
+            bool operator==(const Iterator &that) const
+            {
+                return it_ == that.it_;
+            }
+
+            bool operator!=(const Iterator &that) const
+            {
+                return !(*this == that);
+            }
+
+            Instruction *operator*() const
+            {
+                return it_->GetUser();
+            }
+
+        private:
+            Uses::ConstIterator it_;
+        };
+
+        explicit UsersRange(const Uses &uses) : uses_(uses) {}
+
+        Iterator begin() const
+        {
+            return Iterator(uses_.begin());
+        }
+
+        Iterator end() const
+        {
+            return Iterator(uses_.end());
+        }
+
+        bool IsEmpty() const
+        {
+            return uses_.IsEmpty();
+        }
+
+        // Complexity: O(size)
+        size_t Size() const
+        {
+            return uses_.Size();
+        }
+
+    private:
+        const Uses &uses_;
+    };
+
     Instruction(BasicBlock *ownBB, InstId id, Opcode op, ResultType resType, InstProxyList inputs = {})
-        : ListNode(), ownBB_(ownBB), instId_(id), op_(op), resType_(resType), inputs_(inputs)
+        : ListNode(), ownBB_(ownBB), instId_(id), op_(op), resType_(resType)
     {
         ASSERT(op != Opcode::INVALID);
         ASSERT(resType != ResultType::INVALID);
-        for (auto *input : GetInputs()) {
-            input->AddUsers(this);
+        inputs_.Reserve(inputs.size());
+        for (auto *input : inputs) {
+            inputs_.EmplaceBack(this, input);
         }
     }
 
@@ -57,59 +283,89 @@ public:
 
     Instruction *GetFirstOp() const
     {
-        return inputs_.front();
+        return inputs_.Front().GetValue();
     }
 
     Instruction *GetLastOp() const
     {
-        return inputs_.back();
+        return inputs_.Back().GetValue();
     }
 
-    const Inputs &GetInputs() const
+    InputsRange GetInputs() const
     {
-        return inputs_;
+        return InputsRange(inputs_.begin(), inputs_.end());
     }
 
-    Instruction *GetInput(size_t idx) const;
+    Instruction *GetInput(size_t idx) const
+    {
+        return inputs_[idx].GetValue();
+    }
 
-    void UpdateInputs(Instruction *oldInput, Instruction *newInput);
+    void SetInput(size_t idx, Instruction *newInput)
+    {
+        inputs_[idx].Set(newInput);
+    }
 
     void AddInputs(Instruction *input)
     {
-        inputs_.push_back(input);
+        inputs_.EmplaceBack(this, input);
     }
 
     void AddInputs(const Inputs &inputs)
     {
-        inputs_.insert(inputs_.end(), inputs.begin(), inputs.end());
+        inputs_.Reserve(inputs_.Size() + inputs.Size());
+        for (auto *input : inputs) {
+            inputs_.EmplaceBack(this, input);
+        }
     }
 
-    const Users &GetUsers() const
+    UsersRange GetUsers() const
+    {
+        return UsersRange(users_);
+    }
+
+    const Uses &GetUses() const
     {
         return users_;
     }
 
-    void AddUsers(Instruction *user)
+    bool HasUsers() const
     {
-        users_.insert(user);
+        return users_.NonEmpty();
     }
 
-    void AddUsers(InstProxyList users)
+    // Complexity: O(users)
+    Users CreateUsersSet() const
     {
-        users_.insert(users);
+        auto users = GetUsers();
+        return {users.begin(), users.end()};
     }
 
-    void AddUsers(const Users &users)
+    // Redirects every use of this instruction to newInst
+    void ReplaceUsersWith(Instruction *newInst);
+
+    void InsertInstBefore(Instruction *insertionPoint);
+
+    // Moves the instruction from its block in front of insertionPoint. Unlike UpdateBasicBlock incoming blocks of
+    // phis which use the instruction are kept
+    void MoveBefore(Instruction *insertionPoint);
+
+    // Position inside the basic block, maintained by the block itself
+    uint32_t GetOrder() const
     {
-        users_.insert(users.begin(), users.end());
+        return order_;
     }
 
-    void InsertInstBefore(Instruction *insertionPoint)
+    void SetOrder(uint32_t order)
     {
-        LinkBefore(insertionPoint);
+        order_ = order;
     }
 
-    virtual ~Instruction() = default;
+    virtual ~Instruction()
+    {
+        // users may outlive this instruction only while the whole graph is destroyed
+        users_.UnlinkAll();
+    }
 
     virtual void Dump(std::stringstream &ss) const;
 
@@ -125,17 +381,46 @@ public:
         return static_cast<T *>(this);
     }
 
+    template <typename T>
+    const T *As() const
+    {
+        return static_cast<const T *>(this);
+    }
+
     static constexpr Instruction *EmptyInst = nullptr;
 
+protected:
+    void RemoveInput(size_t idx)
+    {
+        inputs_.Erase(inputs_.begin() + idx);
+    }
+
 private:
+    friend class Use;
+
     BasicBlock *ownBB_;
     InstId instId_;
     Opcode op_;
     ResultType resType_;
-    Inputs inputs_;
-    Users users_;
+    uint32_t order_ {0};
+    utils::SmallVector<Use, InlineInputsCount> inputs_;
+    Uses users_;
 };
 
+void Use::Set(Instruction *value)
+{
+    Unlink();
+    value_ = value;
+    if (value != nullptr) {
+        value->users_.PushBack(this);
+    }
+}
+
+inline size_t Use::GetIndex() const
+{
+    return this - user_->inputs_.Data();
+}
+
 class AssignInst : public Instruction {
 public:
     using ConstOrParamId = int64_t;
@@ -202,7 +487,8 @@ public:
     BranchInst(BasicBlock *ownBB, InstId id, Opcode op, InstProxyList inputs)
         : Instruction(ownBB, id, op, ResultType::VOID, inputs)
     {
-        ASSERT((op == Opcode::BRANCH && inputs.size() == 0) || inputs.size() == 1);
+        // predicate of a shallow copy of conditional branch is added later
+        ASSERT((op == Opcode::BRANCH && inputs.size() == 0) || (op == Opcode::COND_BRANCH && inputs.size() <= 1));
     }
 
     void Dump(std::stringstream &ss) const override;
@@ -223,6 +509,7 @@ public:
     Instruction *ShallowCopy(BasicBlock *newBB, InstId id) const override;
 };
 
+// Inputs of phi are incoming values, GetIncomingBlock(idx) is the predecessor the idx-th value comes from
 class PhiInst : public Instruction {
 public:
     using ValueDependencies = std::unordered_map<Instruction *, std::list<BasicBlock *>>;
@@ -234,23 +521,31 @@ public:
 
     void ResolveDependency(Instruction *value, BasicBlock *bb);
 
-    void UpdateDependencies(Instruction *oldValue, Instruction *newValue);
-
     void UpdateValueBasicBlock(Instruction *value, BasicBlock *oldBB, BasicBlock *newBB);
 
-    bool HasOnlyOneDependency();
+    BasicBlock *GetIncomingBlock(size_t idx) const
+    {
+        return incomingBlocks_[idx];
+    }
 
-    const ValueDependencies &GetValueDependencies() const
+    void SetIncomingBlock(size_t idx, BasicBlock *bb)
     {
-        return valueDeps_;
+        incomingBlocks_[idx] = bb;
     }
 
+    void RemoveDependency(size_t idx);
+
+    bool HasOnlyOneDependency() const;
+
+    // Complexity: O(inputs)
+    ValueDependencies GetValueDependencies() const;
+
     void Dump(std::stringstream &ss) const override;
 
     Instruction *ShallowCopy(BasicBlock *newBB, InstId id) const override;
 
 private:
-    ValueDependencies valueDeps_;
+    utils::SmallVector<BasicBlock *, InlineInputsCount> incomingBlocks_;
 };
 
 class MemoryInst : public Instruction {
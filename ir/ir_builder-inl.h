@@ -18,7 +18,7 @@ InstType *IRBuilder::CreateInstruction(InstArgs... args)
 {
     ASSERT(insertionPoint_ != nullptr);
     auto instId = InstId {graph_->NewInstId()};
-    auto *inst = new InstType {insertionPoint_, instId, std::forward<InstArgs>(args)...};
+    auto *inst = graph_->GetAllocator()->New<InstType>(insertionPoint_, instId, std::forward<InstArgs>(args)...);
     ASSERT(inst->GetOpcode() != Opcode::PHI);
     insertionPoint_->InsertInstBack(inst);
     return inst;
@@ -28,7 +28,7 @@ PhiInst *IRBuilder::CreatePhiInstruction(ResultType resType)
 {
     ASSERT(insertionPoint_ != nullptr);
     auto instId = InstId {graph_->NewInstId(), true};
-    auto *inst = new PhiInst {insertionPoint_, instId, resType};
+    auto *inst = graph_->GetAllocator()->New<PhiInst>(insertionPoint_, instId, resType);
     insertionPoint_->InsertPhiInst(inst);
     return inst;
 }
@@ -18,7 +18,16 @@ static bool IsArithmeticOperands(Instruction *op1, Instruction *op2)
 
 AssignInst *IRBuilder::CreateConstInt(int value)
 {
-    return CreateInstruction<AssignInst>(Opcode::CONSTANT, ResultType::S32, value);
+    // constants of the start block are shared, the others are local to their blocks
+    if (insertionPoint_ != graph_->GetStartBlock()) {
+        return CreateInstruction<AssignInst>(Opcode::CONSTANT, ResultType::S32, value);
+    }
+    auto *constInst = graph_->FindConstant(ResultType::S32, value);
+    if (constInst == nullptr) {
+        constInst = CreateInstruction<AssignInst>(Opcode::CONSTANT, ResultType::S32, value);
+        graph_->RegisterConstant(constInst);
+    }
+    return constInst;
 }
 
 AssignInst *IRBuilder::CreateParam(ResultType type, uint32_t id)
@@ -3,33 +3,35 @@
 
 #include "utils/macros.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace compiler::ir {
 
+// Marker is a pair of slot and epoch. Graph hands out a fresh epoch for every new marker, so marks left by
+// previous markers in the same slot become stale at once and objects never need to be unmarked
 class Marker {
 public:
-    explicit Marker() = default;
+    static constexpr size_t SlotBits = 2;
+    // Number of markers which may be alive on a graph simultaneously
+    static constexpr size_t MaxMarkersCount = 1U << SlotBits;
 
-    explicit Marker(uint64_t value) : value_(value)
-    {
-        // is power of two
-        ASSERT((value & (value - 1)) == 0);
-    }
+    explicit Marker() = default;
 
-    void Mark(Marker marker)
+    explicit Marker(uint64_t epoch, size_t slot) : value_((epoch << SlotBits) | slot)
     {
-        value_ |= marker.value_;
+        ASSERT(epoch != 0);
+        ASSERT(slot < MaxMarkersCount);
     }
 
-    void Unmark(Marker marker)
+    uint64_t GetEpoch() const
     {
-        value_ &= ~marker.value_;
+        return value_ >> SlotBits;
     }
 
-    bool IsMarked(Marker marker) const
+    size_t GetSlot() const
     {
-        return (value_ & marker.value_) != 0;
+        return value_ & (MaxMarkersCount - 1);
     }
 
     bool IsEmpty() const
@@ -41,6 +43,31 @@ private:
     uint64_t value_ = 0;
 };
 
+// Marks of an object: epoch of the last marker set in every slot
+class MarkerSet {
+public:
+    void Mark(Marker marker)
+    {
+        ASSERT(!marker.IsEmpty());
+        epochs_[marker.GetSlot()] = marker.GetEpoch();
+    }
+
+    void Unmark(Marker marker)
+    {
+        ASSERT(!marker.IsEmpty());
+        epochs_[marker.GetSlot()] = 0;
+    }
+
+    bool IsMarked(Marker marker) const
+    {
+        ASSERT(!marker.IsEmpty());
+        return epochs_[marker.GetSlot()] == marker.GetEpoch();
+    }
+
+private:
+    uint64_t epochs_[Marker::MaxMarkersCount] {};
+};
+
 }  // namespace compiler::ir
 
 #endif  // IR_MARKER_H
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "utils/arena_allocator.h"
+#include "utils/macros.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace compiler::tests {
+
+TEST(ARENA_ALLOCATOR, MovedFromArena)
+{
+    constexpr size_t ChunkSize = 1024;
+    auto arena = utils::ArenaAllocator {ChunkSize};
+    auto *first = arena.New<uint64_t>(1U);
+    ASSERT(arena.GetReservedBytes() == ChunkSize);
+
+    auto newArena = utils::ArenaAllocator {std::move(arena)};
+    ASSERT(newArena.GetReservedBytes() == ChunkSize && newArena.GetAllocatedBytes() == sizeof(uint64_t));
+    ASSERT(arena.GetReservedBytes() == 0 && arena.GetAllocatedBytes() == 0);
+
+    // the chunk belongs to the new arena, so the moved-from one starts its own chunk
+    auto *second = arena.New<uint64_t>(2U);
+    ASSERT(arena.GetReservedBytes() == ChunkSize);
+    auto *third = newArena.New<uint64_t>(3U);
+    ASSERT(second != third && *first == 1U && *second == 2U && *third == 3U);
+}
+
+}  // namespace compiler::tests
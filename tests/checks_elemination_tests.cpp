@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "analysis/optimization.h"
+#include "analysis/statistics.h"
 #include "ir/basic_block.h"
 #include "ir/common.h"
 #include "ir/graph.h"
@@ -8,14 +9,15 @@
 #include "ir/instruction.h"
 #include "utils/macros.h"
 
+#include <vector>
+
 namespace compiler::tests {
 
 /**
  *   Source Code:
- *       function foo(): unsigned {
+ *       function foo(c2: int): unsigned {
  *           const c0 = 0;
  *           const c1 = 1;
- *           const c2 = 10;
  *           let mem = new unsigned[c2];
  *           mem[c0] = c0;
  *           mem[c1] = c0;
@@ -28,7 +30,7 @@ namespace compiler::tests {
  *       BB.0:
  *           0.s32 Constant 0
  *           1.s32 Constant 1
- *           2.s32 Constant 10
+ *           2.s32 Parameter 0
  *           3. Br BB.1
  *       BB.1:
  *           4.u32 Mem v2
@@ -48,7 +50,7 @@ namespace compiler::tests {
  *       BB.0:
  *           0.s32 Constant 0
  *           1.s32 Constant 1
- *           2.s32 Constant 10
+ *           2.s32 Parameter 0
  *           3. Br BB.1
  *       BB.1:
  *           4.u32 Mem v2
@@ -72,7 +74,7 @@ TEST(CHECKS_OPT, DominatedChecksElimination)
     irBuilder.SetInsertionPoint(bb0);
     auto *v0 = irBuilder.CreateConstInt(0);
     auto *v1 = irBuilder.CreateConstInt(1);
-    auto *v2 = irBuilder.CreateConstInt(10);
+    auto *v2 = irBuilder.CreateParam(ir::ResultType::S32, 0);
     [[maybe_unused]] auto *v3 = irBuilder.CreateBr(bb1);
 
     irBuilder.SetInsertionPoint(bb1);
@@ -111,10 +113,9 @@ TEST(CHECKS_OPT, DominatedChecksElimination)
 
 /**
  *   Source Code:
- *       function foo(): void {
+ *       function foo(c2: int): void {
  *           const c0 = 0;
  *           const c1 = 1;
- *           const c2 = 10;
  *           let mem1 = new unsigned[c2];
  *           let mem2 = new unsigned[c2];
  *           mem1[c1] = c0;
@@ -126,7 +127,7 @@ TEST(CHECKS_OPT, DominatedChecksElimination)
  *       BB.0:
  *           0.s32 Constant 0
  *           1.s32 Constant 1
- *           2.s32 Constant 10
+ *           2.s32 Parameter 0
  *           3. Br BB.1
  *       BB.1:
  *           4.u32 Mem v2
@@ -143,7 +144,7 @@ TEST(CHECKS_OPT, DominatedChecksElimination)
  *       BB.0:
  *           0.s32 Constant 0
  *           1.s32 Constant 1
- *           2.s32 Constant 10
+ *           2.s32 Parameter 0
  *           3. Br BB.1
  *       BB.1:
  *           4.u32 Mem v2
@@ -167,7 +168,7 @@ TEST(CHECKS_OPT, DifferentMemoryChecksElemination)
     irBuilder.SetInsertionPoint(bb0);
     auto *v0 = irBuilder.CreateConstInt(0);
     auto *v1 = irBuilder.CreateConstInt(1);
-    auto *v2 = irBuilder.CreateConstInt(10);
+    auto *v2 = irBuilder.CreateParam(ir::ResultType::S32, 0);
     [[maybe_unused]] auto *v3 = irBuilder.CreateBr(bb1);
 
     irBuilder.SetInsertionPoint(bb1);
@@ -200,4 +201,320 @@ TEST(CHECKS_OPT, DifferentMemoryChecksElemination)
     });
 }
 
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.s32 Constant 0
+ *           3.s32 Constant 1
+ *           4.s32 Mem v0
+ *           5.s32 Mem v1
+ *           6. Br BB.1
+ *       BB.1:
+ *           7p.s32 Phi v2:BB.0, v14:BB.2
+ *           8.b CmpLT v7, v0
+ *           9. CondBr v8, BB.2, BB.3
+ *       BB.2:
+ *          10. Check Bound v4, v7
+ *          11.s32 Load v4, v7
+ *          12. Check Bound v5, v7
+ *          13. Store v5, v7, v11
+ *          14.s32 Add v7, v3
+ *          15. Br BB.1
+ *       BB.3:
+ *          16.s32 Return v0
+ *
+ *   After checks optimizer:
+ *       v7 is in [0, v0) inside of BB.2, so v10 is eliminated. Length of v5 is not compared, v12 is kept
+ */
+TEST(CHECKS_OPT, LoopBoundChecks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateConstInt(0);
+    auto *v3 = irBuilder.CreateConstInt(1);
+    auto *v4 = irBuilder.CreateMemory(ir::ResultType::S32, v0);
+    auto *v5 = irBuilder.CreateMemory(ir::ResultType::S32, v1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v7 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v7, v0), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateBoundCheck(v4, v7);
+    auto *v11 = irBuilder.CreateLoad(v4, v7);
+    auto *v12 = irBuilder.CreateBoundCheck(v5, v7);
+    irBuilder.CreateStore(v5, v7, v11);
+    auto *v14 = irBuilder.CreateAdd(v7, v3);
+    irBuilder.CreateBr(bb1);
+    v7->ResolveDependency(v2, bb0);
+    v7->ResolveDependency(v14, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateRet(v0);
+
+    CheckOptimizer checksElem(&graph);
+    ASSERT(checksElem.Run());
+    ASSERT(!checksElem.Run());
+
+    std::vector<ir::Instruction *> remainingChecks;
+    bb2->IterateOverInstructions([&remainingChecks](ir::Instruction *inst) {
+        if (inst->GetOpcode() == ir::Opcode::CHECK) {
+            remainingChecks.push_back(inst);
+        }
+        return false;
+    });
+    ASSERT(remainingChecks == std::vector<ir::Instruction *>({v12}));
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 3
+ *           2.s32 Constant 5
+ *           3.s32 Constant -1
+ *           4.u32 Mem v0
+ *           5. Br BB.1
+ *       BB.1:
+ *           6. Check Bound v4, v2
+ *           7. Check Bound v4, v1
+ *           8. Check Bound v4, v2
+ *           9. Check Bound v4, v3
+ *          10. Return void
+ *
+ *   After checks optimizer:
+ *       v6 passes only if the length is greater than 5, so v7 and v8 are removed. Negative index of v9 is out of range
+ */
+TEST(CHECKS_OPT, BoundChecksSubsumption)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(3);
+    auto *v2 = irBuilder.CreateConstInt(5);
+    auto *v3 = irBuilder.CreateConstInt(-1);
+    auto *v4 = irBuilder.CreateMemory(ir::ResultType::U32, v0);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v6 = irBuilder.CreateBoundCheck(v4, v2);
+    irBuilder.CreateBoundCheck(v4, v1);
+    irBuilder.CreateBoundCheck(v4, v2);
+    auto *v9 = irBuilder.CreateBoundCheck(v4, v3);
+    irBuilder.CreateRetVoid();
+
+    CheckOptimizer checksElem(&graph);
+    ASSERT(checksElem.Run());
+
+    std::vector<ir::Instruction *> remainingChecks;
+    bb1->IterateOverInstructions([&remainingChecks](ir::Instruction *inst) {
+        if (inst->GetOpcode() == ir::Opcode::CHECK) {
+            remainingChecks.push_back(inst);
+        }
+        return false;
+    });
+    ASSERT(remainingChecks == std::vector<ir::Instruction *>({v6, v9}));
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Constant 0
+ *           1.s32 Constant 1
+ *           2.s32 Constant 10
+ *           3.s32 Constant 2
+ *           4.u32 Mem v2
+ *           5. Br BB.1
+ *       BB.1:
+ *           6p.s32 Phi v0:BB.0, v12:BB.2
+ *           7.b CmpLT v6, v2
+ *           8. CondBr v7, BB.2, BB.3
+ *       BB.2:
+ *           9. Check Bound v4, v6
+ *          10.s32 Shl v6, v1
+ *          11. Check Bound v4, v10
+ *          12.s32 Add v6, v1
+ *          13. Check Bound v4, v12
+ *          14. Store v4, v6, v12
+ *          15. Br BB.1
+ *       BB.3:
+ *          16. Check Bound v4, v3
+ *          17.s32 Load v4, v3
+ *          18.s32 Return v17
+ *
+ *   After checks optimizer:
+ *       v6 is in [0, 9] inside of BB.2, so v9 and v16 are removed. v10 is in [0, 18] and v12 is in [1, 10], they
+ *       may be out of range of the memory with 10 elements
+ */
+TEST(CHECKS_OPT, ConstantCountChecks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateConstInt(0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    auto *v2 = irBuilder.CreateConstInt(10);
+    auto *v3 = irBuilder.CreateConstInt(2);
+    auto *v4 = irBuilder.CreateMemory(ir::ResultType::U32, v2);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v6, v2), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateBoundCheck(v4, v6);
+    auto *v10 = irBuilder.CreateShl(v6, v1);
+    auto *v11 = irBuilder.CreateBoundCheck(v4, v10);
+    auto *v12 = irBuilder.CreateAdd(v6, v1);
+    auto *v13 = irBuilder.CreateBoundCheck(v4, v12);
+    irBuilder.CreateStore(v4, v6, v12);
+    irBuilder.CreateBr(bb1);
+    v6->ResolveDependency(v0, bb0);
+    v6->ResolveDependency(v12, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateBoundCheck(v4, v3);
+    irBuilder.CreateRet(irBuilder.CreateLoad(v4, v3));
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    CheckOptimizer checksElem(&graph);
+    ASSERT(checksElem.Run());
+    ASSERT(statistics.GetTotalCounter(StatCounter::ELIMINATED_CHECKS) == 2);
+
+    std::vector<ir::Instruction *> remainingChecks;
+    graph.IterateOverBlocks([&remainingChecks](ir::BasicBlock *bb) {
+        bb->IterateOverInstructions([&remainingChecks](ir::Instruction *inst) {
+            if (inst->GetOpcode() == ir::Opcode::CHECK) {
+                remainingChecks.push_back(inst);
+            }
+            return false;
+        });
+    });
+    ASSERT(remainingChecks == std::vector<ir::Instruction *>({v11, v13}));
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.u32 Mem v0
+ *           2. Check Nil v1
+ *           3. Return void
+ *       BB.1: (unreachable)
+ *           4. Check Nil v1
+ *           5. Return void
+ *
+ *   After checks optimizer:
+ *       the graph is not changed, unreachable block is not dominated by BB.0
+ */
+TEST(CHECKS_OPT, UnreachableBlockChecks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateMemory(ir::ResultType::U32, v0);
+    auto *v2 = irBuilder.CreateNullCheck(v1);
+    irBuilder.CreateRetVoid();
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreateNullCheck(v1);
+    irBuilder.CreateRetVoid();
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    CheckOptimizer checksElem(&graph);
+    ASSERT(!checksElem.Run());
+    ASSERT(statistics.GetTotalCounter(StatCounter::ELIMINATED_CHECKS) == 0);
+    ASSERT(v2->GetBasicBlock() == bb0);
+    ASSERT(v4->GetBasicBlock() == bb1);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Constant 0
+ *           1.s32 Constant 1
+ *           2.s32 Constant 10
+ *           3.u32 Mem v2
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v0:BB.0, v7:BB.1
+ *           6. Check Bound v3, v5
+ *           7.s32 Add v5, v1
+ *           8.b CmpLT v7, v2
+ *           9. CondBr v8, BB.1, BB.2
+ *       BB.2:
+ *          10.s32 Return v7
+ *
+ *   After checks optimizer:
+ *       no branch condition dominates v6, the loop takes 9 back edges, so v5 is in [0, 9] and v6 is removed
+ */
+TEST(CHECKS_OPT, InductionVariableChecks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateConstInt(0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    auto *v2 = irBuilder.CreateConstInt(10);
+    auto *v3 = irBuilder.CreateMemory(ir::ResultType::U32, v2);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateBoundCheck(v3, v5);
+    auto *v7 = irBuilder.CreateAdd(v5, v1);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v7, v2), bb1, bb2);
+    v5->ResolveDependency(v0, bb0);
+    v5->ResolveDependency(v7, bb1);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateRet(v7);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    CheckOptimizer checksElem(&graph);
+    ASSERT(checksElem.Run());
+    ASSERT(statistics.GetTotalCounter(StatCounter::ELIMINATED_CHECKS) == 1);
+    bb1->IterateOverInstructions([](ir::Instruction *inst) {
+        ASSERT(inst->GetOpcode() != ir::Opcode::CHECK);
+        return false;
+    });
+}
+
 }  // namespace compiler::tests
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "analysis/analysis.h"
+#include "analysis/optimization.h"
+#include "analysis/pass_manager.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "tests/generated_graphs.h"
+#include "utils/macros.h"
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 1
+ *           2.s32 Constant 10
+ *           3. Br BB.1
+ *       BB.1:
+ *           4p.s32 Phi v1:BB.0, v5:BB.1
+ *           5.s32 Add v4, v1
+ *           6.s32 Shl v0, v1
+ *           7.u32 Mem v2
+ *           8.u32 Mem v2
+ *           9. Store v8, v1, v0
+ *          10.b CmpLT v0, v2
+ *          11. CondBr v10, BB.1, BB.2
+ *       BB.2:
+ *          12.s32 Return v0
+ *
+ *   After DCE:
+ *       loop counter v4, v5 without users outside of its cycle, v6 and v7 are removed
+ */
+TEST(DCE_OPT, DeadInstructions)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    auto *v2 = irBuilder.CreateConstInt(10);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v5 = irBuilder.CreateAdd(v4, v1);
+    v4->ResolveDependency(v1, bb0);
+    v4->ResolveDependency(v5, bb1);
+    irBuilder.CreateShl(v0, v1);
+    irBuilder.CreateMemory(ir::ResultType::U32, v2);
+    auto *v8 = irBuilder.CreateMemory(ir::ResultType::U32, v2);
+    irBuilder.CreateStore(v8, v1, v0);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v0, v2), bb1, bb2);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateRet(v0);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    DCEOptimizer dceOpt(&graph);
+    ASSERT(dceOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::REMOVED_INSTS) == 4);
+    ASSERT(statistics.GetTotalCounter(StatCounter::REMOVED_BLOCKS) == 0);
+    ASSERT(bb0->GetAliveInstructionCount() == 4);
+    // mem, store, compare and branch
+    ASSERT(bb1->GetAliveInstructionCount() == 4);
+    ASSERT(v1->CreateUsersSet().size() == 1);
+    ASSERT(!dceOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 1
+ *           2. Br BB.1
+ *       BB.1:
+ *           3. Br BB.3
+ *       BB.2:
+ *           4.s32 Add v0, v1
+ *           5. Br BB.3
+ *       BB.3:
+ *           6p.s32 Phi v0:BB.1, v4:BB.2
+ *           7.s32 Return v6
+ *
+ *   After DCE:
+ *       unreachable BB.2 is removed together with the phi input which comes from it, then v1 is dead
+ */
+TEST(DCE_OPT, UnreachableBlocks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    irBuilder.CreateBr(bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v4 = irBuilder.CreateAdd(v0, v1);
+    irBuilder.CreateBr(bb3);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    v6->ResolveDependency(v0, bb1);
+    v6->ResolveDependency(v4, bb2);
+    auto *v7 = irBuilder.CreateRet(v6);
+
+    auto passManager = PassManager {&graph};
+    auto *analysisManager = passManager.GetAnalysisManager();
+    analysisManager->GetAnalysis<DominatorsTree>();
+    ASSERT(passManager.Run<DCEOptimizer>());
+
+    // analyses of the old control flow are dropped
+    ASSERT(!analysisManager->IsValid<DominatorsTree>());
+    ASSERT(graph.GetBlocksCount() == 3);
+    ASSERT(bb3->GetPredecessors() == ir::BasicBlock::Predecessors {bb1});
+    ASSERT(v6->GetInputs().Size() == 1 && v6->GetInput(0) == v0);
+    // constant is used by the removed block only
+    ASSERT(bb0->GetAliveInstructionCount() == 2);
+    ASSERT(graph.FindConstant(ir::ResultType::S32, 1) == nullptr);
+
+    PeepHoleOptimizer(&graph).Run();
+    ASSERT(v7->GetFirstOp() == v0);
+}
+
+TEST(DCE_OPT, GeneratedGraphs)
+{
+    auto statistics = CompilerStatistics {};
+    auto options = GetGeneratedGraphsOptions();
+    options.phisCount = 2;
+    ForEachGeneratedGraph(options, [&statistics](ir::Graph *graph) {
+        PeepHoleOptimizer(graph).Run();
+        graph->SetStatistics(&statistics);
+        RunToFixpoint<DCEOptimizer>(graph);
+        // every instruction without side effects is used
+        graph->IterateOverBlocks([](ir::BasicBlock *bb) {
+            bb->IterateOverInstructions([](ir::Instruction *inst) {
+                auto opcode = inst->GetOpcode();
+                ASSERT(inst->HasUsers() || opcode == ir::Opcode::PARAMETER || opcode == ir::Opcode::BRANCH ||
+                       opcode == ir::Opcode::COND_BRANCH || opcode == ir::Opcode::RETURN ||
+                       opcode == ir::Opcode::STORE || opcode == ir::Opcode::CHECK ||
+                       opcode == ir::Opcode::CALL_STATIC);
+                return false;
+            });
+        });
+    });
+    ASSERT(statistics.GetTotalCounter(StatCounter::REMOVED_INSTS) != 0);
+}
+
+}  // namespace compiler::tests
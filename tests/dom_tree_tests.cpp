@@ -7,6 +7,9 @@
 #include "ir/ir_builder.h"
 #include "ir/instruction.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace compiler::tests {
 
 using BBSet = std::set<ir::BasicBlock *>;
@@ -298,4 +301,239 @@ TEST(DOMINATOR_TREE, ExampleGraph3)
     ASSERT(tree.GetImmediateDominator(bb8) == bb1);
 }
 
+namespace {
+
+// Reference dominators: block dominates every block which becomes unreachable without it
+std::unordered_map<ir::BasicBlock *, BBSet> BuildReferenceDominators(const std::vector<ir::BasicBlock *> &blocks)
+{
+    auto reachableWithout = [&blocks](ir::BasicBlock *removed) {
+        BBSet visited;
+        std::vector<ir::BasicBlock *> stack {blocks.front()};
+        while (!stack.empty()) {
+            auto *bb = stack.back();
+            stack.pop_back();
+            if (bb == removed || !visited.insert(bb).second) {
+                continue;
+            }
+            for (auto *succ : bb->GetSuccessors()) {
+                stack.push_back(succ);
+            }
+        }
+        return visited;
+    };
+
+    auto reachable = reachableWithout(nullptr);
+    std::unordered_map<ir::BasicBlock *, BBSet> dominators;
+    for (auto *dominator : reachable) {
+        auto reachableSubset = reachableWithout(dominator);
+        for (auto *bb : reachable) {
+            if (bb != dominator && reachableSubset.count(bb) == 0) {
+                dominators[bb].insert(dominator);
+            }
+        }
+    }
+    return dominators;
+}
+
+}  // namespace
+
+TEST(DOMINATOR_TREE, RandomGraphs)
+{
+    uint64_t seed = 42;
+    auto nextRandom = [&seed](uint64_t bound) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 33U) % bound;
+    };
+
+    for (auto graphIdx = 0; graphIdx < 50; ++graphIdx) {
+        auto graph = ir::Graph {};
+        auto blocksCount = 2 + nextRandom(40);
+        std::vector<ir::BasicBlock *> blocks;
+        for (auto idx = 0U; idx < blocksCount; ++idx) {
+            blocks.push_back(ir::BasicBlock::Create(&graph));
+        }
+        for (auto idx = 0U; idx < blocksCount; ++idx) {
+            // forward edge keeps most of the blocks reachable, random edges create loops and joins
+            auto *trueSucc = blocks[(idx + 1) % blocksCount];
+            if (idx + 1 < blocksCount && nextRandom(8) != 0) {
+                blocks[idx]->SetTrueSuccessor(trueSucc);
+            }
+            auto *falseSucc = blocks[nextRandom(blocksCount)];
+            if (nextRandom(2) == 0 && falseSucc != blocks[idx]->GetTrueSuccessor()) {
+                blocks[idx]->SetFalseSuccessor(falseSucc);
+            }
+        }
+
+        DominatorsTree tree {&graph};
+        // second run must rebuild the tree from scratch
+        tree.Run();
+        tree.Run();
+
+        auto reference = BuildReferenceDominators(blocks);
+        for (auto &[bb, dominators] : reference) {
+            ASSERT(tree.GetDominators(bb) == dominators);
+            ASSERT(tree.DoesBlockDominatesOn(bb, bb));
+            for (auto *dominator : dominators) {
+                ASSERT(tree.DoesBlockDominatesOn(bb, dominator));
+                ASSERT(!tree.DoesBlockDominatesOn(dominator, bb));
+            }
+        }
+        // start block has no dominators and is absent in the reference
+        auto depth = [&reference](ir::BasicBlock *bb) {
+            auto it = reference.find(bb);
+            return it == reference.end() ? 0 : it->second.size();
+        };
+        for (auto &[bb1, dominators1] : reference) {
+            for (auto &[bb2, dominators2] : reference) {
+                // nearest common dominator is the deepest block dominating both of them
+                ir::BasicBlock *expected = nullptr;
+                for (auto *dominator : dominators1) {
+                    if (dominators2.count(dominator) != 0 &&
+                        (expected == nullptr || depth(dominator) > depth(expected))) {
+                        expected = dominator;
+                    }
+                }
+                ASSERT(tree.GetImmediateDominatorFor(bb1, bb2) == expected);
+            }
+        }
+    }
+}
+
+
+TEST(DOMINATOR_TREE, InstructionsInOneBlock)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+    auto *bb = ir::BasicBlock::Create(&graph);
+    irBuilder.SetInsertionPoint(bb);
+
+    std::vector<ir::Instruction *> insts {irBuilder.CreateParam(ir::ResultType::S32, 0)};
+    for (auto idx = 0; idx < 32; ++idx) {
+        insts.push_back(irBuilder.CreateAdd(insts.back(), insts.front()));
+    }
+    DominatorsTree tree {&graph};
+    tree.Run();
+
+    // phi goes to the front, appended instructions get orders without renumbering
+    insts.insert(insts.begin(), irBuilder.CreatePhi(ir::ResultType::S32));
+    insts.push_back(irBuilder.CreateAdd(insts.back(), insts.back()));
+    // repeated insertion at the same point exhausts the gap between neighbours
+    auto insertionIdx = insts.size() / 2;
+    for (auto idx = 0; idx < 8; ++idx) {
+        auto *inst = irBuilder.CreateAdd(insts.front(), insts.front());
+        inst->Unlink();
+        inst->InsertInstBefore(insts[insertionIdx]);
+        insts.insert(insts.begin() + insertionIdx, inst);
+    }
+
+    for (size_t idx1 = 0; idx1 < insts.size(); ++idx1) {
+        ASSERT(tree.GetImmediateDominatorFor(insts[idx1], insts[idx1]) == (idx1 == 0 ? nullptr : insts[idx1 - 1]));
+        for (size_t idx2 = 0; idx2 < insts.size(); ++idx2) {
+            ASSERT(tree.DoesInstructionDominatesOn(insts[idx2], insts[idx1]) == (idx1 < idx2));
+        }
+    }
+}
+
+TEST(DOMINATOR_TREE, DeepGraph)
+{
+    // recursive traversals overflow the native stack on such chains
+    constexpr size_t BlocksCount = 200000;
+    auto graph = ir::Graph {};
+    std::vector<ir::BasicBlock *> blocks {ir::BasicBlock::Create(&graph)};
+    for (size_t idx = 1; idx < BlocksCount; ++idx) {
+        blocks.push_back(ir::BasicBlock::Create(&graph));
+        blocks[idx - 1]->SetTrueSuccessor(blocks[idx]);
+    }
+
+    DFS dfs {&graph};
+    dfs.Run();
+    ASSERT(dfs.GetDfsVector() == blocks);
+
+    RPO rpo {&graph};
+    rpo.Run();
+    ASSERT(rpo.GetRpoVector() == blocks);
+
+    DominatorsTree tree {&graph};
+    tree.Run();
+    ASSERT(tree.GetImmediateDominator(blocks.back()) == blocks[BlocksCount - 2]);
+    ASSERT(tree.DoesBlockDominatesOn(blocks.back(), blocks.front()));
+}
+
+/**
+ *  Graph:
+ *           -----
+ *           | 0 |
+ *           -----
+ *          /     \
+ *     -----       -----
+ *     | 1 |       | 2 |      -----
+ *     -----       -----      | 4 | (unreachable)
+ *          \     /           -----
+ *           -----
+ *           | 3 |
+ *           -----
+ */
+TEST(DOMINATOR_TREE, CachedRpo)
+{
+    auto graph = ir::Graph {};
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+    bb0->SetTrueSuccessor(bb1);
+    bb0->SetFalseSuccessor(bb2);
+    bb1->SetTrueSuccessor(bb3);
+    bb2->SetTrueSuccessor(bb3);
+    bb4->SetTrueSuccessor(bb3);
+
+    using RpoVector = std::vector<ir::BasicBlock *>;
+    ASSERT(graph.GetRpoBlocks() == RpoVector({bb0, bb2, bb1, bb3}));
+    // order is reused while control flow stays the same
+    auto *cachedRpo = graph.GetRpoBlocks().data();
+    auto cfgVersion = graph.GetCfgVersion();
+    ASSERT(graph.GetRpoBlocks().data() == cachedRpo);
+
+    auto *bb5 = ir::BasicBlock::Create(&graph);
+    bb3->SetTrueSuccessor(bb5);
+    ASSERT(graph.GetCfgVersion() != cfgVersion);
+    ASSERT(graph.GetRpoBlocks() == RpoVector({bb0, bb2, bb1, bb3, bb5}));
+
+    // every analysis takes a new marker, they must not run out on a long pipeline
+    for (auto idx = 0; idx < 100; ++idx) {
+        DFS {&graph}.Run();
+        DominatorsTree {&graph}.Run();
+    }
+}
+
+TEST(DOMINATOR_TREE, UnreachableBlocks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    bb0->SetTrueSuccessor(bb1);
+    bb2->SetTrueSuccessor(bb1);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v1 = irBuilder.CreateAdd(v0, v0);
+    auto *v2 = irBuilder.CreateAdd(v1, v0);
+
+    DominatorsTree tree {&graph};
+    tree.Run();
+    // the unreachable block has no vertex, queries on it must not touch the tables
+    ASSERT(tree.GetImmediateDominator(bb2) == nullptr);
+    ASSERT(tree.GetImmediateDominatorFor(bb1, bb2) == nullptr);
+    ASSERT(tree.GetImmediateDominatorFor(v0, v1) == nullptr);
+    ASSERT(!tree.DoesBlockDominatesOn(bb2, bb0));
+    ASSERT(!tree.DoesBlockDominatesOn(bb1, bb2));
+    ASSERT(!tree.DoesBlockDominatesOn(bb2, bb2));
+    ASSERT(!tree.DoesInstructionDominatesOn(v1, v0));
+    ASSERT(!tree.DoesInstructionDominatesOn(v2, v1));
+    ASSERT(tree.DoesBlockDominatesOn(bb1, bb0));
+}
+
 }  // namespace compiler::tests
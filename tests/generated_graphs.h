@@ -0,0 +1,45 @@
+#ifndef TESTS_GENERATED_GRAPHS_H
+#define TESTS_GENERATED_GRAPHS_H
+
+#include "ir/graph.h"
+#include "ir/graph_generator.h"
+#include "utils/macros.h"
+
+#include <cstdint>
+
+namespace compiler::tests {
+
+// Options of the graphs which properties of analyses and passes are checked on, only the seed is overwritten
+inline ir::GeneratorOptions GetGeneratedGraphsOptions()
+{
+    auto options = ir::GeneratorOptions {};
+    options.blocksCount = 100;
+    options.maxLoopDepth = 3;
+    options.loopProbability = 0.5;
+    return options;
+}
+
+// Calls `callback(graph)` for a fresh graph generated with every seed in [0, seedsCount)
+template <typename CallbackT>
+void ForEachGeneratedGraph(ir::GeneratorOptions options, CallbackT callback, uint64_t seedsCount = 10)
+{
+    for (uint64_t seed = 0; seed < seedsCount; ++seed) {
+        options.seed = seed;
+        auto graph = ir::Graph {};
+        ir::GraphGenerator {options}.GenerateMethod(&graph);
+        callback(&graph);
+    }
+}
+
+// Runs the pass on the graph, the second run must find nothing left to change
+template <typename PassT>
+void RunToFixpoint(ir::Graph *graph)
+{
+    PassT pass(graph);
+    pass.Run();
+    ASSERT(!pass.Run());
+}
+
+}  // namespace compiler::tests
+
+#endif  // TESTS_GENERATED_GRAPHS_H
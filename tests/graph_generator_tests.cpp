@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "analysis/analysis.h"
+#include "analysis/optimization.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/graph_generator.h"
+#include "ir/instruction.h"
+
+#include <sstream>
+
+namespace compiler::tests {
+
+namespace {
+
+// Every input dominates its user, phi inputs dominate ends of their incoming blocks
+bool IsValidSSA(ir::Graph *graph)
+{
+    DominatorsTree tree {graph};
+    tree.Run();
+    bool isValid = true;
+    for (auto *bb : graph->GetRpoBlocks()) {
+        bb->IterateOverInstructions([&tree, &isValid](ir::Instruction *inst) {
+            for (size_t idx = 0; idx < inst->GetInputs().Size(); ++idx) {
+                auto *input = inst->GetInput(idx);
+                if (inst->GetOpcode() == ir::Opcode::PHI) {
+                    auto *incomingBB = inst->As<ir::PhiInst>()->GetIncomingBlock(idx);
+                    isValid &= tree.DoesBlockDominatesOn(incomingBB, input->GetBasicBlock());
+                } else {
+                    isValid &= tree.DoesInstructionDominatesOn(inst, input);
+                }
+            }
+            return !isValid;
+        });
+    }
+    return isValid;
+}
+
+size_t CountInstructions(ir::Graph *graph, ir::Opcode opcode)
+{
+    size_t count = 0;
+    graph->IterateOverBlocks([&count, opcode](ir::BasicBlock *bb) {
+        bb->IterateOverInstructions([&count, opcode](ir::Instruction *inst) {
+            count += inst->GetOpcode() == opcode ? 1 : 0;
+            return false;
+        });
+    });
+    return count;
+}
+
+}  // namespace
+
+TEST(GRAPH_GENERATOR, Deterministic)
+{
+    auto options = ir::GeneratorOptions {};
+    options.seed = 7;
+    options.blocksCount = 64;
+
+    auto dump = [&options]() {
+        auto graph = ir::Graph {};
+        ir::GraphGenerator {options}.GenerateMethod(&graph);
+        std::stringstream ss;
+        graph.Dump(ss);
+        return ss.str();
+    };
+    ASSERT(dump() == dump());
+    auto firstDump = dump();
+    options.seed = 8;
+    ASSERT(dump() != firstDump);
+}
+
+TEST(GRAPH_GENERATOR, ValidSSA)
+{
+    for (uint64_t seed = 0; seed < 20; ++seed) {
+        auto options = ir::GeneratorOptions {};
+        options.seed = seed;
+        options.blocksCount = 200;
+        options.maxLoopDepth = 3;
+        options.phisCount = 2;
+
+        auto graph = ir::Graph {};
+        ir::GraphGenerator {options}.GenerateMethod(&graph);
+        ASSERT(IsValidSSA(&graph));
+        // every block is reachable
+        ASSERT(graph.GetRpoBlocks().size() == graph.GetBlocksCount());
+        ASSERT(graph.GetBlocksCount() >= options.blocksCount);
+        ASSERT(graph.GetBlocksCount() <= options.blocksCount + 3);
+        ASSERT(CountInstructions(&graph, ir::Opcode::PHI) != 0);
+        ASSERT(CountInstructions(&graph, ir::Opcode::CHECK) != 0);
+    }
+}
+
+TEST(GRAPH_GENERATOR, PipelineOnCallGraph)
+{
+    for (uint64_t seed = 0; seed < 10; ++seed) {
+        auto options = ir::GeneratorOptions {};
+        options.seed = seed;
+        options.blocksCount = 40;
+        options.methodsCount = 4;
+        options.callsPerMethod = 2;
+
+        auto callGraph = ir::CallGraph {};
+        auto methods = ir::GraphGenerator {options}.GenerateMethods(&callGraph);
+        ASSERT(methods.size() == options.methodsCount);
+        auto *root = methods.front().get();
+        ASSERT(CountInstructions(root, ir::Opcode::CALL_STATIC) == options.callsPerMethod);
+        ASSERT(CountInstructions(methods.back().get(), ir::Opcode::CALL_STATIC) == 0);
+
+        InliningOptimizer(root).Run();
+        ASSERT(CountInstructions(root, ir::Opcode::CALL_STATIC) == 0);
+        ASSERT(IsValidSSA(root));
+
+        auto checksCount = CountInstructions(root, ir::Opcode::CHECK);
+        PeepHoleOptimizer(root).Run();
+        CheckOptimizer(root).Run();
+        ASSERT(IsValidSSA(root));
+        ASSERT(CountInstructions(root, ir::Opcode::CHECK) < checksCount);
+    }
+}
+
+}  // namespace compiler::tests
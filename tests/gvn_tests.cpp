@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "analysis/optimization.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2. Br BB.1
+ *       BB.1:
+ *           3.s32 Add v0, v1
+ *           4.b CmpLT v0, v1
+ *           5. CondBr v4, BB.2, BB.3
+ *       BB.2:
+ *           6.s32 Add v1, v0
+ *           7.s32 Xor v6, v0
+ *           8.b CmpLE v0, v1
+ *           9. Br BB.4
+ *       BB.3:
+ *          10.s32 Xor v3, v0
+ *          11.b CmpLT v0, v1
+ *          12. Br BB.4
+ *       BB.4:
+ *          13.s32 Xor v3, v0
+ *          14.s32 Phi v7, v10
+ *          15.s32 Return v13
+ *
+ *   After GVN:
+ *       v6 is replaced by v3, then v7 gets the same inputs as v10 but they are in different branches
+ *       v11 is replaced by v4, v8 has other compare flags
+ *       v13 is not dominated by v7 and v10, so it is kept
+ */
+TEST(GVN_OPT, DominatingValues)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v3 = irBuilder.CreateAdd(v0, v1);
+    auto *v4 = irBuilder.CreateCmpLT(v0, v1);
+    irBuilder.CreateCondBr(v4, bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v6 = irBuilder.CreateAdd(v1, v0);
+    auto *v7 = irBuilder.CreateXor(v6, v0);
+    auto *v8 = irBuilder.CreateCmpLE(v0, v1);
+    irBuilder.CreateBr(bb4);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v10 = irBuilder.CreateXor(v3, v0);
+    irBuilder.CreateCmpLT(v0, v1);
+    irBuilder.CreateBr(bb4);
+
+    irBuilder.SetInsertionPoint(bb4);
+    auto *v13 = irBuilder.CreateXor(v3, v0);
+    auto *v14 = irBuilder.CreatePhi(ir::ResultType::S32);
+    v14->ResolveDependency(v7, bb2);
+    v14->ResolveDependency(v10, bb3);
+    auto *v15 = irBuilder.CreateRet(v13);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    GVNOptimizer gvnOpt(&graph);
+    ASSERT(gvnOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::REDUNDANT_INSTS) == 2);
+    ASSERT(v7->GetFirstOp() == v3);
+    ASSERT(v14->GetInput(0) == v7 && v14->GetInput(1) == v10);
+    ASSERT(v15->GetFirstOp() == v13);
+    ASSERT(v8->CreateUsersSet().empty() && v8->GetBasicBlock() == bb2);
+    ASSERT(v4->CreateUsersSet().size() == 1);
+    ASSERT(bb3->GetAliveInstructionCount() == 2);
+    ASSERT(!gvnOpt.Run());
+}
+
+/**
+ *   callee(a0):                  caller(a0):
+ *       BB.0:                        BB.0:
+ *           0.s32 Parameter 0            0.s32 Parameter 0
+ *           1.s32 Constant 7             1. Br BB.1
+ *           2. Br BB.1               BB.1:
+ *       BB.1:                            2.s32 CallStatic callee v0
+ *           3.s32 Shl v0, v1             3.s32 CallStatic callee v0
+ *           4.s32 Add v3, v0             4.s32 Add v2, v3
+ *           5.s32 Return v4              5.s32 Return v4
+ *
+ *   After inlining, peephole and GVN the second inlined body is replaced by the first one
+ */
+TEST(GVN_OPT, InlinedTwice)
+{
+    auto callGraph = ir::CallGraph {};
+    auto callee = ir::Graph {&callGraph, "callee"};
+    auto caller = ir::Graph {&callGraph, "caller"};
+    {
+        auto irBuilder = ir::IRBuilder {&callee};
+        auto *bb0 = ir::BasicBlock::Create(&callee);
+        auto *bb1 = ir::BasicBlock::Create(&callee);
+        irBuilder.SetInsertionPoint(bb0);
+        auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+        auto *v1 = irBuilder.CreateConstInt(7);
+        irBuilder.CreateBr(bb1);
+        irBuilder.SetInsertionPoint(bb1);
+        irBuilder.CreateRet(irBuilder.CreateAdd(irBuilder.CreateShl(v0, v1), v0));
+    }
+    ir::Instruction *v4 = nullptr;
+    {
+        auto irBuilder = ir::IRBuilder {&caller};
+        auto *bb0 = ir::BasicBlock::Create(&caller);
+        auto *bb1 = ir::BasicBlock::Create(&caller);
+        irBuilder.SetInsertionPoint(bb0);
+        auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+        irBuilder.CreateBr(bb1);
+        irBuilder.SetInsertionPoint(bb1);
+        auto *v2 = irBuilder.CreateCallStatic(callee.GetMethodId(), ir::ResultType::S32, {v0});
+        auto *v3 = irBuilder.CreateCallStatic(callee.GetMethodId(), ir::ResultType::S32, {v0});
+        v4 = irBuilder.CreateAdd(v2, v3);
+        irBuilder.CreateRet(v4);
+    }
+
+    ASSERT(InliningOptimizer(&caller).Run());
+    // removes single input phis of the inlined returns
+    PeepHoleOptimizer(&caller).Run();
+    ASSERT(v4->GetFirstOp() != v4->GetLastOp());
+
+    auto statistics = CompilerStatistics {};
+    caller.SetStatistics(&statistics);
+    ASSERT(GVNOptimizer(&caller).Run());
+    // shift and add of the second body
+    ASSERT(statistics.GetTotalCounter(StatCounter::REDUNDANT_INSTS) == 2);
+    ASSERT(v4->GetFirstOp() == v4->GetLastOp());
+    ASSERT(v4->GetFirstOp()->GetOpcode() == ir::Opcode::ADD);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include "analysis/induction_analysis.h"
+#include "analysis/loop_analysis.h"
+#include "analysis/pass_manager.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3.s32 Constant 10
+ *           4.s32 Constant 4
+ *           5. Br BB.1
+ *       BB.1:
+ *           6p.s32 Phi v1:BB.0, v11:BB.2
+ *           7.b CmpLT v6, v3
+ *           8. CondBr v7, BB.2, BB.3
+ *       BB.2:
+ *           9.s32 Mul v4, v6
+ *          10.s32 Add v0, v9
+ *          11.s32 Add v6, v2
+ *          12. Br BB.1
+ *       BB.3:
+ *          13.s32 Return v0
+ */
+TEST(INDUCTION_ANALYSIS, TopTestedLoop)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateConstInt(10);
+    auto *v4 = irBuilder.CreateConstInt(4);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v7 = irBuilder.CreateCmpLT(v6, v3);
+    irBuilder.CreateCondBr(v7, bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v9 = irBuilder.CreateMul(v4, v6);
+    auto *v10 = irBuilder.CreateAdd(v0, v9);
+    auto *v11 = irBuilder.CreateAdd(v6, v2);
+    irBuilder.CreateBr(bb1);
+    v6->ResolveDependency(v1, bb0);
+    v6->ResolveDependency(v11, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateRet(v0);
+
+    AnalysisManager analysisManager {&graph};
+    InductionAnalysis inductionAnalysis {&graph, &analysisManager};
+    inductionAnalysis.Run();
+    auto *loop = analysisManager.GetAnalysis<LoopAnalysis>().GetLoop(bb1);
+
+    const auto *basicVar = inductionAnalysis.GetInductionVariable(v6);
+    ASSERT(basicVar != nullptr && basicVar->IsBasic() && basicVar->loop == loop);
+    ASSERT(basicVar->start == v1 && basicVar->next == v11 && basicVar->step == 1);
+
+    const auto *mulVar = inductionAnalysis.GetInductionVariable(v9);
+    ASSERT(mulVar != nullptr && !mulVar->IsBasic() && mulVar->basic == v6 && mulVar->parent == basicVar);
+    ASSERT(mulVar->scale == 4 && mulVar->step == 4);
+    const auto *addVar = inductionAnalysis.GetInductionVariable(v10);
+    ASSERT(addVar != nullptr && addVar->parent == mulVar && addVar->scale == 4 && addVar->step == 4);
+    const auto *nextVar = inductionAnalysis.GetInductionVariable(v11);
+    ASSERT(nextVar != nullptr && nextVar->parent == basicVar && nextVar->scale == 1 && nextVar->step == 1);
+
+    ASSERT(inductionAnalysis.GetInductionVariable(v0) == nullptr);
+    ASSERT(inductionAnalysis.GetInductionVariable(v7) == nullptr);
+    ASSERT(inductionAnalysis.GetInductionVariables(loop) ==
+           std::vector<const InductionVariable *>({basicVar, mulVar, addVar, nextVar}));
+
+    // the header is entered with 0, ..., 10 and the last value leaves the loop
+    ASSERT(inductionAnalysis.GetTripCount(loop) == 10U);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Constant 20
+ *           1.s32 Constant -3
+ *           2.s32 Constant 2
+ *           3.s32 Constant 1
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v0:BB.0, v7:BB.1
+ *           6.s32 Shl v5, v3
+ *           7.s32 Add v5, v1
+ *           8.b CmpLT v2, v7
+ *           9. CondBr v8, BB.1, BB.2
+ *       BB.2:
+ *          10.s32 Return v6
+ */
+TEST(INDUCTION_ANALYSIS, BottomTestedLoop)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateConstInt(20);
+    auto *v1 = irBuilder.CreateConstInt(-3);
+    auto *v2 = irBuilder.CreateConstInt(2);
+    auto *v3 = irBuilder.CreateConstInt(1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v6 = irBuilder.CreateShl(v5, v3);
+    auto *v7 = irBuilder.CreateAdd(v5, v1);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v2, v7), bb1, bb2);
+    v5->ResolveDependency(v0, bb0);
+    v5->ResolveDependency(v7, bb1);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateRet(v6);
+
+    AnalysisManager analysisManager {&graph};
+    InductionAnalysis inductionAnalysis {&graph, &analysisManager};
+    inductionAnalysis.Run();
+    auto *loop = analysisManager.GetAnalysis<LoopAnalysis>().GetLoop(bb1);
+
+    const auto *basicVar = inductionAnalysis.GetInductionVariable(v5);
+    ASSERT(basicVar != nullptr && basicVar->IsBasic() && basicVar->step == -3);
+    const auto *shlVar = inductionAnalysis.GetInductionVariable(v6);
+    ASSERT(shlVar != nullptr && shlVar->parent == basicVar && shlVar->scale == 2 && shlVar->step == -6);
+
+    // v7 takes 17, 14, 11, 8, 5 on the back edges and 2 leaves the loop
+    ASSERT(inductionAnalysis.GetTripCount(loop) == 5U);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3. Br BB.1
+ *       BB.1:
+ *           4p.s32 Phi v1:BB.0, v10:BB.2
+ *           5p.s32 Phi v1:BB.0, v9:BB.2
+ *           6.b CmpLE v0, v4
+ *           7. CondBr v6, BB.3, BB.2
+ *       BB.2:
+ *           8.s32 Mul v4, v0
+ *           9.s32 Add v5, v0
+ *          10.s32 Add v4, v2
+ *          11. Br BB.1
+ *       BB.3:
+ *          12.s32 Return v4
+ */
+TEST(INDUCTION_ANALYSIS, UnknownTripCount)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLE(v0, v4), bb3, bb2);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v8 = irBuilder.CreateMul(v4, v0);
+    auto *v9 = irBuilder.CreateAdd(v5, v0);
+    auto *v10 = irBuilder.CreateAdd(v4, v2);
+    irBuilder.CreateBr(bb1);
+    v4->ResolveDependency(v1, bb0);
+    v4->ResolveDependency(v10, bb2);
+    v5->ResolveDependency(v1, bb0);
+    v5->ResolveDependency(v9, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateRet(v4);
+
+    AnalysisManager analysisManager {&graph};
+    InductionAnalysis inductionAnalysis {&graph, &analysisManager};
+    inductionAnalysis.Run();
+    auto *loop = analysisManager.GetAnalysis<LoopAnalysis>().GetLoop(bb1);
+
+    // the step of v5 and the factor of v8 are not constants
+    ASSERT(inductionAnalysis.GetInductionVariable(v4) != nullptr);
+    ASSERT(inductionAnalysis.GetInductionVariable(v5) == nullptr);
+    ASSERT(inductionAnalysis.GetInductionVariable(v8) == nullptr);
+    ASSERT(inductionAnalysis.GetInductionVariable(v9) == nullptr);
+    // the bound of the exit test is not a constant
+    ASSERT(!inductionAnalysis.GetTripCount(loop).has_value());
+}
+
+}  // namespace compiler::tests
@@ -81,48 +81,48 @@ TEST(IR_BUILDER, Factorial)
 
     ASSERT(v0->GetOpcode() == ir::Opcode::PARAMETER);
     ASSERT(v0->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v0->GetUsers() == ir::Instruction::Users {v6});
+    ASSERT(v0->CreateUsersSet() == ir::Instruction::Users {v6});
     ASSERT(v0->GetBasicBlock() == bb1);
 
     ASSERT(v1->GetOpcode() == ir::Opcode::CONSTANT);
     ASSERT(v1->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v1->GetUsers() == ir::Instruction::Users({v4, v9}));
+    ASSERT(v1->CreateUsersSet() == ir::Instruction::Users({v4, v9}));
     ASSERT(v1->GetBasicBlock() == bb1);
 
     ASSERT(v2->GetOpcode() == ir::Opcode::CONSTANT);
     ASSERT(v2->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v2->GetUsers() == ir::Instruction::Users {v5});
+    ASSERT(v2->CreateUsersSet() == ir::Instruction::Users {v5});
     ASSERT(v2->GetBasicBlock() == bb1);
 
     ASSERT(v3->GetOpcode() == ir::Opcode::BRANCH);
     ASSERT(v3->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v3->GetUsers() == ir::Instruction::Users {});
+    ASSERT(v3->CreateUsersSet() == ir::Instruction::Users {});
     ASSERT(v3->GetBasicBlock() == bb1);
 
     ASSERT(bb1->GetTrueSuccessor() == bb2);
     ASSERT(bb1->GetFalseSuccessor() == nullptr);
 
     ASSERT(v4->GetOpcode() == ir::Opcode::PHI);
-    ASSERT(v4->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v4->GetUsers() == ir::Instruction::Users({v8, v11}));
+    ASSERT(v4->GetInputs() == ir::Instruction::Inputs({v1, v8}));
+    ASSERT(v4->CreateUsersSet() == ir::Instruction::Users({v8, v11}));
     ASSERT(v4->GetValueDependencies() == ir::PhiInst::ValueDependencies({{v1, {bb1}}, {v8, {bb3}}}));
     ASSERT(v4->GetBasicBlock() == bb2);
 
     ASSERT(v5->GetOpcode() == ir::Opcode::PHI);
-    ASSERT(v5->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v5->GetUsers() == ir::Instruction::Users({v6, v8, v9}));
+    ASSERT(v5->GetInputs() == ir::Instruction::Inputs({v2, v9}));
+    ASSERT(v5->CreateUsersSet() == ir::Instruction::Users({v6, v8, v9}));
     ASSERT(v5->GetValueDependencies() == ir::PhiInst::ValueDependencies({{v2, {bb1}}, {v9, {bb3}}}));
     ASSERT(v5->GetBasicBlock() == bb2);
 
     ASSERT(v6->GetOpcode() == ir::Opcode::COMPARE);
     ASSERT(v6->GetCmpFlags() == ir::CmpFlags::LE);
     ASSERT(v6->GetInputs() == ir::Instruction::Inputs({v5, v0}));
-    ASSERT(v6->GetUsers() == ir::Instruction::Users {v7});
+    ASSERT(v6->CreateUsersSet() == ir::Instruction::Users {v7});
     ASSERT(v6->GetBasicBlock() == bb2);
 
     ASSERT(v7->GetOpcode() == ir::Opcode::COND_BRANCH);
     ASSERT(v7->GetInputs() == ir::Instruction::Inputs {v6});
-    ASSERT(v7->GetUsers() == ir::Instruction::Users {});
+    ASSERT(v7->CreateUsersSet() == ir::Instruction::Users {});
     ASSERT(v7->GetBasicBlock() == bb2);
 
     ASSERT(bb2->GetTrueSuccessor() == bb3);
@@ -130,17 +130,17 @@ TEST(IR_BUILDER, Factorial)
 
     ASSERT(v8->GetOpcode() == ir::Opcode::MUL);
     ASSERT(v8->GetInputs() == ir::Instruction::Inputs({v4, v5}));
-    ASSERT(v8->GetUsers() == ir::Instruction::Users {v4});
+    ASSERT(v8->CreateUsersSet() == ir::Instruction::Users {v4});
     ASSERT(v8->GetBasicBlock() == bb3);
 
     ASSERT(v9->GetOpcode() == ir::Opcode::ADD);
     ASSERT(v9->GetInputs() == ir::Instruction::Inputs({v5, v1}));
-    ASSERT(v9->GetUsers() == ir::Instruction::Users {v5});
+    ASSERT(v9->CreateUsersSet() == ir::Instruction::Users {v5});
     ASSERT(v9->GetBasicBlock() == bb3);
 
     ASSERT(v10->GetOpcode() == ir::Opcode::BRANCH);
     ASSERT(v10->GetInputs() == ir::Instruction::Inputs {});
-    ASSERT(v10->GetUsers() == ir::Instruction::Users {});
+    ASSERT(v10->CreateUsersSet() == ir::Instruction::Users {});
     ASSERT(v10->GetBasicBlock() == bb3);
 
     ASSERT(bb3->GetTrueSuccessor() == bb2);
@@ -148,11 +148,185 @@ TEST(IR_BUILDER, Factorial)
 
     ASSERT(v11->GetOpcode() == ir::Opcode::RETURN);
     ASSERT(v11->GetInputs() == ir::Instruction::Inputs {v4});
-    ASSERT(v11->GetUsers() == ir::Instruction::Users {});
+    ASSERT(v11->CreateUsersSet() == ir::Instruction::Users {});
     ASSERT(v11->GetBasicBlock() == bb4);
 
     ASSERT(bb4->GetTrueSuccessor() == nullptr);
     ASSERT(bb4->GetFalseSuccessor() == nullptr);
 }
 
-}  // namespace compiler::tests
\ No newline at end of file
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 1
+ *           2.s32 Constant 2
+ *           3.s32 Constant 3
+ *           4.s32 Constant 4
+ *           5.s32 CallSt id: 0 Ret: s32 v0, v1, v2, v3, v4
+ *           6.s32 Add v5, v1
+ *           7.s32 Return v6
+ */
+TEST(IR_BUILDER, CallWithSpilledInputs)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    auto *v2 = irBuilder.CreateConstInt(2);
+    auto *v3 = irBuilder.CreateConstInt(3);
+    auto *v4 = irBuilder.CreateConstInt(4);
+    auto *v5 = irBuilder.CreateCallStatic(0, ir::ResultType::S32, {v0, v1, v2, v3, v4});
+    auto *v6 = irBuilder.CreateAdd(v5, v1);
+    [[maybe_unused]] auto *v7 = irBuilder.CreateRet(v6);
+
+    ASSERT(v5->GetInputs() == ir::Instruction::Inputs({v0, v1, v2, v3, v4}));
+    ASSERT(v5->GetInput(0) == v0);
+    ASSERT(v5->GetInput(3) == v3);
+    ASSERT(v5->GetInput(4) == v4);
+    ASSERT(v5->GetLastOp() == v4);
+
+    v5->AddInputs(v6);
+    ASSERT(v5->GetInputs().Size() == 6);
+    ASSERT(v5->GetInput(5) == v6);
+    ASSERT(v5->GetInput(2) == v2);
+    ASSERT(v1->CreateUsersSet() == ir::Instruction::Users({v5, v6}));
+    ASSERT(v6->CreateUsersSet() == ir::Instruction::Users({v5, v7}));
+
+    ASSERT(v6->GetInput(0) == v5);
+    ASSERT(v6->GetInput(1) == v1);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.b Parameter 2
+ *           3. If v2, BB.1, BB.2
+ *       BB.1:
+ *           4.s32 Add v0, v0
+ *           5. Br BB.2
+ *       BB.2:
+ *           6p.s32 Phi v0:BB.0, v4:BB.1
+ *           7.s32 Return v6
+ *
+ *   After replacing users of v0 with v1:
+ *       BB.1:
+ *           4.s32 Add v1, v1
+ *       BB.2:
+ *           6p.s32 Phi v1:BB.0, v4:BB.1
+ */
+TEST(IR_BUILDER, ReplaceUsers)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateParam(ir::ResultType::BOOL, 2);
+    [[maybe_unused]] auto *v3 = irBuilder.CreateCondBr(v2, bb1, bb2);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreateAdd(v0, v0);
+    [[maybe_unused]] auto *v5 = irBuilder.CreateBr(bb2);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    [[maybe_unused]] auto *v7 = irBuilder.CreateRet(v6);
+
+    v6->ResolveDependency(v0, bb0);
+    v6->ResolveDependency(v4, bb1);
+
+    ASSERT(v0->GetUses().Size() == 3);
+    ASSERT(v0->CreateUsersSet() == ir::Instruction::Users({v4, v6}));
+
+    v0->ReplaceUsersWith(v1);
+
+    ASSERT(!v0->HasUsers());
+    ASSERT(v1->GetUses().Size() == 3);
+    ASSERT(v1->CreateUsersSet() == ir::Instruction::Users({v4, v6}));
+    ASSERT(v4->GetInputs() == ir::Instruction::Inputs({v1, v1}));
+    ASSERT(v6->GetInputs() == ir::Instruction::Inputs({v1, v4}));
+    ASSERT(v6->GetIncomingBlock(0) == bb0);
+    ASSERT(v6->GetIncomingBlock(1) == bb1);
+
+    ir::Instruction::UpdateUsersAndEliminate(v4, v1);
+    ASSERT(v1->GetUses().Size() == 2);
+    ASSERT(v1->CreateUsersSet() == ir::Instruction::Users({v6}));
+    ASSERT(v6->GetInputs() == ir::Instruction::Inputs({v1, v1}));
+    ASSERT(v6->HasOnlyOneDependency());
+    ASSERT(bb1->GetAliveInstructionCount() == 1);
+}
+
+TEST(IR_BUILDER, Markers)
+{
+    auto graph = ir::Graph {};
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    auto marker1 = graph.NewMarker();
+    auto marker2 = graph.NewMarker();
+    bb0->Mark(marker1);
+    bb1->Mark(marker2);
+    ASSERT(bb0->IsMarked(marker1) && !bb0->IsMarked(marker2));
+    ASSERT(bb1->IsMarked(marker2) && !bb1->IsMarked(marker1));
+    bb1->Unmark(marker2);
+    ASSERT(!bb1->IsMarked(marker2));
+
+    // released slot is reused, but marks of the released marker are not visible to the new one
+    graph.ReleaseMarker(marker1);
+    auto marker3 = graph.NewMarker();
+    ASSERT(marker3.GetSlot() == marker1.GetSlot());
+    ASSERT(!bb0->IsMarked(marker3));
+    graph.ReleaseMarker(marker3);
+    graph.ReleaseMarker(marker2);
+
+    // number of markers is limited only by simultaneously alive ones
+    for (auto idx = 0; idx < 1000; ++idx) {
+        ir::MarkerHolder holder1 {&graph};
+        ir::MarkerHolder holder2 {&graph};
+        ASSERT(!bb0->IsMarked(holder1.GetMarker()) && !bb0->IsMarked(holder2.GetMarker()));
+        bb0->Mark(holder1.GetMarker());
+        bb0->Mark(holder2.GetMarker());
+    }
+}
+
+TEST(IR_BUILDER, ConstantPool)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateConstInt(5);
+    auto *v1 = irBuilder.CreateConstInt(7);
+    ASSERT(irBuilder.CreateConstInt(5) == v0);
+    ASSERT(bb0->GetAliveInstructionCount() == 2);
+    ASSERT(graph.FindConstant(ir::ResultType::S32, 7) == v1);
+    // constants of different types are not shared
+    ASSERT(graph.FindConstant(ir::ResultType::U8, 7) == nullptr);
+    irBuilder.CreateBr(bb1);
+
+    // constants out of the start block are not shared
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v3 = irBuilder.CreateConstInt(5);
+    ASSERT(v3 != v0);
+    irBuilder.CreateRet(v3);
+
+    ir::Instruction::Eliminate(v1);
+    ASSERT(graph.FindConstant(ir::ResultType::S32, 7) == nullptr);
+    ASSERT(graph.FindConstant(ir::ResultType::S32, 5) == v0);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,537 @@
+#include <gtest/gtest.h>
+
+#include "analysis/analysis.h"
+#include "analysis/loop_analysis.h"
+#include "analysis/optimization.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "tests/generated_graphs.h"
+#include "utils/macros.h"
+
+#include <algorithm>
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.s32 Constant 1
+ *           3.s32 Constant 0
+ *           4.b CmpLT v0, v1
+ *           5. CondBr v4, BB.1, BB.2
+ *       BB.1:
+ *           6p.s32 Phi v3:BB.0, v9:BB.1
+ *           7.s32 Mul v0, v1
+ *           8.s32 Add v7, v2
+ *           9.s32 Add v6, v8
+ *          10.b CmpLT v9, v1
+ *          11. CondBr v10, BB.1, BB.2
+ *       BB.2:
+ *          12.s32 Return v0
+ *
+ *   After LICM:
+ *       BB.0 jumps to the new pre-header BB.3 which computes v7 and v8, v6 takes v3 from BB.3
+ */
+TEST(LICM_OPT, InvariantsWithNewPreHeader)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateConstInt(0);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v0, v1), bb1, bb2);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v7 = irBuilder.CreateMul(v0, v1);
+    auto *v8 = irBuilder.CreateAdd(v7, v2);
+    auto *v9 = irBuilder.CreateAdd(v6, v8);
+    auto *v10 = irBuilder.CreateCmpLT(v9, v1);
+    irBuilder.CreateCondBr(v10, bb1, bb2);
+    v6->ResolveDependency(v3, bb0);
+    v6->ResolveDependency(v9, bb1);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateRet(v0);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(licmOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) == 2);
+    ASSERT(graph.GetBlocksCount() == 4);
+    auto *preHeader = bb0->GetTrueSuccessor();
+    ASSERT(preHeader != bb1 && preHeader->GetTrueSuccessor() == bb1 && preHeader->GetFalseSuccessor() == nullptr);
+    ASSERT(bb1->GetPredecessors() == ir::BasicBlock::Predecessors({preHeader, bb1}));
+    ASSERT(v7->GetBasicBlock() == preHeader && v8->GetBasicBlock() == preHeader);
+    ASSERT(preHeader->IsInstructionBefore(v7, v8));
+    ASSERT(v9->GetBasicBlock() == bb1 && v10->GetBasicBlock() == bb1);
+    ASSERT(v6->GetInputs().Size() == 2);
+    ASSERT(v6->GetInput(0) == v9 && v6->GetIncomingBlock(0) == bb1);
+    ASSERT(v6->GetInput(1) == v3 && v6->GetIncomingBlock(1) == preHeader);
+    ASSERT(!licmOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.b CmpLT v0, v1
+ *           3. CondBr v2, BB.1, BB.2
+ *       BB.1:
+ *           4. Br BB.3
+ *       BB.2:
+ *           5. Br BB.3
+ *       BB.3:
+ *           6p.s32 Phi v0:BB.1, v1:BB.2, v8:BB.3
+ *           7.s32 Xor v0, v1
+ *           8.s32 Add v6, v7
+ *           9.b CmpLT v8, v1
+ *          10. CondBr v9, BB.3, BB.4
+ *       BB.4:
+ *          11.s32 Return v8
+ *
+ *   After LICM:
+ *       the new pre-header merges values of BB.1 and BB.2 by a phi, v6 takes it as a single input from outside
+ */
+TEST(LICM_OPT, PreHeaderPhi)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v0, v1), bb1, bb2);
+
+    irBuilder.SetInsertionPoint(bb1);
+    irBuilder.CreateBr(bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateBr(bb3);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v7 = irBuilder.CreateXor(v0, v1);
+    auto *v8 = irBuilder.CreateAdd(v6, v7);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v8, v1), bb3, bb4);
+    v6->ResolveDependency(v0, bb1);
+    v6->ResolveDependency(v1, bb2);
+    v6->ResolveDependency(v8, bb3);
+
+    irBuilder.SetInsertionPoint(bb4);
+    irBuilder.CreateRet(v8);
+
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(licmOpt.Run());
+
+    auto *preHeader = bb1->GetTrueSuccessor();
+    ASSERT(preHeader == bb2->GetTrueSuccessor() && preHeader != bb3);
+    ASSERT(v7->GetBasicBlock() == preHeader);
+
+    auto *preHeaderPhi = preHeader->GetFirstInstruction()->As<ir::PhiInst>();
+    ASSERT(preHeaderPhi->GetOpcode() == ir::Opcode::PHI);
+    ASSERT(preHeaderPhi->GetInputs().Size() == 2);
+    for (size_t idx = 0; idx < 2; ++idx) {
+        auto *incomingBlock = preHeaderPhi->GetIncomingBlock(idx);
+        ASSERT(preHeaderPhi->GetInput(idx) == (incomingBlock == bb1 ? v0 : v1));
+    }
+    ASSERT(v6->GetInputs().Size() == 2);
+    ASSERT(v6->GetInput(1) == preHeaderPhi && v6->GetIncomingBlock(1) == preHeader);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 1
+ *           2.s32 Mem v0
+ *           3.s32 Mem v0
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v1:BB.0, v13:BB.3
+ *           6.s32 Load v2, v0
+ *           7.s32 Load v3, v0
+ *           8. Store v2, v5, v7
+ *           9.b CmpLT v5, v0
+ *          10. CondBr v9, BB.2, BB.3
+ *       BB.2:
+ *          11.s32 Load v3, v1
+ *          12. Br BB.3
+ *       BB.3:
+ *          13.s32 Add v5, v1
+ *          14.b CmpLT v13, v0
+ *          15. CondBr v14, BB.1, BB.4
+ *       BB.4:
+ *          16.s32 Return v6
+ *
+ *   After LICM:
+ *       only v7 is hoisted to BB.0: memory of v6 is stored in the loop and v11 is not loaded on every iteration
+ */
+TEST(LICM_OPT, Loads)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    auto *v2 = irBuilder.CreateMemory(ir::ResultType::S32, v0);
+    auto *v3 = irBuilder.CreateMemory(ir::ResultType::S32, v0);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v6 = irBuilder.CreateLoad(v2, v0);
+    auto *v7 = irBuilder.CreateLoad(v3, v0);
+    irBuilder.CreateStore(v2, v5, v7);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v5, v0), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v11 = irBuilder.CreateLoad(v3, v1);
+    irBuilder.CreateBr(bb3);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v13 = irBuilder.CreateAdd(v5, v1);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v13, v0), bb1, bb4);
+    v5->ResolveDependency(v1, bb0);
+    v5->ResolveDependency(v13, bb3);
+
+    irBuilder.SetInsertionPoint(bb4);
+    irBuilder.CreateRet(v6);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(licmOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) == 1);
+    ASSERT(graph.GetBlocksCount() == 5);
+    ASSERT(v7->GetBasicBlock() == bb0);
+    ASSERT(v6->GetBasicBlock() == bb1);
+    ASSERT(v11->GetBasicBlock() == bb2);
+    ASSERT(!licmOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3.s32 Mem v0
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v1:BB.0, v11:BB.1
+ *           6. Check Nil v3
+ *           7. Check Bound v3, v1
+ *           8.s32 Load v3, v1
+ *           9. Check Bound v3, v5
+ *          10. Store v3, v5, v8
+ *          11.s32 Add v5, v2
+ *          12.b CmpLT v11, v0
+ *          13. CondBr v12, BB.1, BB.2
+ *       BB.2:
+ *          14.s32 Return v0
+ *
+ *   After LICM:
+ *       v6 and v7 are executed on every iteration and become guards in BB.0, v8 is stored in the loop,
+ *       v9 depends on the loop
+ */
+TEST(LICM_OPT, InvariantChecks)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateMemory(ir::ResultType::S32, v0);
+    auto *v4 = irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v6 = irBuilder.CreateNullCheck(v3);
+    auto *v7 = irBuilder.CreateBoundCheck(v3, v1);
+    auto *v8 = irBuilder.CreateLoad(v3, v1);
+    auto *v9 = irBuilder.CreateBoundCheck(v3, v5);
+    irBuilder.CreateStore(v3, v5, v8);
+    auto *v11 = irBuilder.CreateAdd(v5, v2);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v11, v0), bb1, bb2);
+    v5->ResolveDependency(v1, bb0);
+    v5->ResolveDependency(v11, bb1);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateRet(v0);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(licmOpt.Run());
+    ASSERT(!licmOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) == 2);
+    ASSERT(v6->GetBasicBlock() == bb0 && v7->GetBasicBlock() == bb0);
+    ASSERT(bb0->IsInstructionBefore(v6, v7) && bb0->IsInstructionBefore(v7, v4));
+    ASSERT(v8->GetBasicBlock() == bb1 && v9->GetBasicBlock() == bb1);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3.s32 Mem v0
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v1:BB.0, v8:BB.1
+ *           6. Store v3, v1, v5
+ *           7. Check Nil v3
+ *           8.s32 Add v5, v2
+ *           9.b CmpLT v8, v0
+ *          10. CondBr v9, BB.1, BB.2
+ *       BB.2:
+ *          11.s32 Return v0
+ *
+ *   v7 is invariant, but the store of the first iteration is executed before it, so the check stays in the loop
+ */
+TEST(LICM_OPT, CheckAfterStore)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateMemory(ir::ResultType::S32, v0);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v6 = irBuilder.CreateStore(v3, v1, v5);
+    auto *v7 = irBuilder.CreateNullCheck(v3);
+    auto *v8 = irBuilder.CreateAdd(v5, v2);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v8, v0), bb1, bb2);
+    v5->ResolveDependency(v1, bb0);
+    v5->ResolveDependency(v8, bb1);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateRet(v0);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(!licmOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) == 0);
+    ASSERT(graph.GetBlocksCount() == 3);
+    ASSERT(v7->GetBasicBlock() == bb1 && bb1->IsInstructionBefore(v6, v7));
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.s32 Constant 0
+ *           3.s32 Constant 1
+ *           4.s32 Mem v1
+ *           5. Br BB.1
+ *       BB.1:
+ *           6p.s32 Phi v2:BB.0, v10:BB.2
+ *           7.b CmpLT v6, v0
+ *           8. CondBr v7, BB.2, BB.3
+ *       BB.2:
+ *           9. Check Nil v4
+ *          10.s32 Add v6, v3
+ *          11. Br BB.1
+ *       BB.3:
+ *          12.s32 Return v0
+ *
+ *   v9 is invariant, but the body of the top tested loop is not executed if v0 <= 0. Loops are not rotated,
+ *   so hoisting the check would speculate it and it stays in the loop
+ */
+TEST(LICM_OPT, CheckInLoopBody)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateConstInt(0);
+    auto *v3 = irBuilder.CreateConstInt(1);
+    auto *v4 = irBuilder.CreateMemory(ir::ResultType::S32, v1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v6, v0), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v9 = irBuilder.CreateNullCheck(v4);
+    auto *v10 = irBuilder.CreateAdd(v6, v3);
+    irBuilder.CreateBr(bb1);
+    v6->ResolveDependency(v2, bb0);
+    v6->ResolveDependency(v10, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateRet(v0);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(!licmOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) == 0);
+    ASSERT(graph.GetBlocksCount() == 4);
+    ASSERT(v9->GetBasicBlock() == bb2);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.b CmpLT v0, v1
+ *           3. CondBr v2, BB.1, BB.3
+ *       BB.1:
+ *           4. Br BB.2
+ *       BB.2:
+ *           5. Br BB.3
+ *       BB.3:
+ *           6. CondBr v2, BB.2, BB.4
+ *       BB.4:
+ *           7.s32 Add v0, v1
+ *           8.b CmpLT v7, v1
+ *           9. CondBr v8, BB.1, BB.5
+ *       BB.5:
+ *          10.s32 Return v7
+ *
+ *   BB.4 is reached from BB.0 through BB.3 bypassing BB.1, the loop of BB.1 is irreducible and v7, v8 stay
+ */
+TEST(LICM_OPT, EntryIntoInnerLoop)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+    auto *bb5 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateCmpLT(v0, v1);
+    irBuilder.CreateCondBr(v2, bb1, bb3);
+
+    irBuilder.SetInsertionPoint(bb1);
+    irBuilder.CreateBr(bb2);
+
+    irBuilder.SetInsertionPoint(bb2);
+    irBuilder.CreateBr(bb3);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateCondBr(v2, bb2, bb4);
+
+    irBuilder.SetInsertionPoint(bb4);
+    auto *v7 = irBuilder.CreateAdd(v0, v1);
+    auto *v8 = irBuilder.CreateCmpLT(v7, v1);
+    irBuilder.CreateCondBr(v8, bb1, bb5);
+
+    irBuilder.SetInsertionPoint(bb5);
+    irBuilder.CreateRet(v7);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    LICMOptimizer licmOpt(&graph);
+    ASSERT(!licmOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) == 0);
+    ASSERT(graph.GetBlocksCount() == 6);
+    ASSERT(v7->GetBasicBlock() == bb4 && v8->GetBasicBlock() == bb4);
+}
+
+TEST(LICM_OPT, GeneratedGraphs)
+{
+    auto statistics = CompilerStatistics {};
+    ForEachGeneratedGraph(GetGeneratedGraphsOptions(), [&statistics](ir::Graph *graph) {
+        graph->SetStatistics(&statistics);
+        RunToFixpoint<LICMOptimizer>(graph);
+
+        LoopAnalysis loopAnalysis {graph};
+        loopAnalysis.Run();
+        auto &domTree = loopAnalysis.GetDominatorsTree();
+        graph->IterateOverBlocks([&loopAnalysis, &domTree](ir::BasicBlock *bb) {
+            bb->IterateOverInstructions([&loopAnalysis, &domTree, bb](ir::Instruction *inst) {
+                // moved values still dominate their users
+                for (auto *user : inst->GetUsers()) {
+                    if (user->GetOpcode() != ir::Opcode::PHI) {
+                        ASSERT(domTree.DoesInstructionDominatesOn(user, inst));
+                    }
+                }
+                // arithmetic which is left in a loop depends on the loop
+                auto opcode = inst->GetOpcode();
+                auto *loop = loopAnalysis.GetLoop(bb);
+                if (!loop->IsRoot() && (opcode == ir::Opcode::ADD || opcode == ir::Opcode::MUL ||
+                                        opcode == ir::Opcode::SHL || opcode == ir::Opcode::XOR ||
+                                        opcode == ir::Opcode::COMPARE)) {
+                    auto inputs = inst->GetInputs();
+                    ASSERT(std::any_of(inputs.begin(), inputs.end(), [&loopAnalysis, loop](ir::Instruction *input) {
+                        return loop->Contains(loopAnalysis.GetLoop(input->GetBasicBlock()));
+                    }));
+                }
+                return false;
+            });
+        });
+    });
+    ASSERT(statistics.GetTotalCounter(StatCounter::HOISTED_INSTS) != 0);
+}
+
+}  // namespace compiler::tests
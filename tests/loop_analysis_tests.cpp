@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include "analysis/loop_analysis.h"
+#include "analysis/pass_manager.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+#include "tests/generated_graphs.h"
+#include "utils/macros.h"
+
+#include <set>
+#include <vector>
+
+namespace compiler::tests {
+
+using BBSet = std::set<ir::BasicBlock *>;
+
+static BBSet ToSet(const std::vector<ir::BasicBlock *> &blocks)
+{
+    return {blocks.begin(), blocks.end()};
+}
+
+/**
+ *  Graph:                     Loop tree:
+ *      0 -> 1                     root: 0, 6
+ *      1 -> 2                       loop 1 (header 1): 1, 5
+ *      2 -> 3                         loop 2 (header 2): 2, 3, 4
+ *      3 -> 4, 2
+ *      4 -> 2, 5
+ *      5 -> 1, 6
+ */
+TEST(LOOP_ANALYSIS, NestedLoops)
+{
+    auto graph = ir::Graph {};
+
+    std::vector<ir::BasicBlock *> bbs;
+    for (size_t idx = 0; idx < 7; ++idx) {
+        bbs.push_back(ir::BasicBlock::Create(&graph));
+    }
+
+    bbs[0]->SetTrueSuccessor(bbs[1]);
+    bbs[1]->SetTrueSuccessor(bbs[2]);
+    bbs[2]->SetTrueSuccessor(bbs[3]);
+    bbs[3]->SetTrueSuccessor(bbs[4]);
+    bbs[3]->SetFalseSuccessor(bbs[2]);
+    bbs[4]->SetTrueSuccessor(bbs[2]);
+    bbs[4]->SetFalseSuccessor(bbs[5]);
+    bbs[5]->SetTrueSuccessor(bbs[1]);
+    bbs[5]->SetFalseSuccessor(bbs[6]);
+
+    LoopAnalysis loopAnalysis {&graph};
+    loopAnalysis.Run();
+
+    auto *root = loopAnalysis.GetRootLoop();
+    ASSERT(root->IsRoot());
+    ASSERT(root->GetDepth() == 0);
+    ASSERT(ToSet(root->GetBlocks()) == BBSet({bbs[0], bbs[6]}));
+    ASSERT(loopAnalysis.GetLoops().size() == 2);
+
+    auto *outer = loopAnalysis.GetLoop(bbs[1]);
+    ASSERT(!outer->IsRoot() && !outer->IsIrreducible());
+    ASSERT(outer->GetHeader() == bbs[1]);
+    ASSERT(outer->GetBlocks().front() == bbs[1]);
+    ASSERT(ToSet(outer->GetBlocks()) == BBSet({bbs[1], bbs[5]}));
+    ASSERT(outer->GetBackEdges() == std::vector<ir::BasicBlock *>({bbs[5]}));
+    ASSERT(outer->GetPreHeader() == bbs[0]);
+    ASSERT(outer->GetExitBlocks() == std::vector<ir::BasicBlock *>({bbs[6]}));
+    ASSERT(outer->GetOuterLoop() == root);
+    ASSERT(outer->GetDepth() == 1);
+
+    auto *inner = loopAnalysis.GetLoop(bbs[3]);
+    ASSERT(inner->GetHeader() == bbs[2]);
+    ASSERT(ToSet(inner->GetBlocks()) == BBSet({bbs[2], bbs[3], bbs[4]}));
+    ASSERT(ToSet(inner->GetBackEdges()) == BBSet({bbs[3], bbs[4]}));
+    ASSERT(inner->GetPreHeader() == bbs[1]);
+    ASSERT(inner->GetExitBlocks() == std::vector<ir::BasicBlock *>({bbs[5]}));
+    ASSERT(inner->GetOuterLoop() == outer);
+    ASSERT(outer->GetInnerLoops() == std::vector<Loop *>({inner}));
+    ASSERT(inner->GetDepth() == 2);
+
+    ASSERT(root->Contains(inner) && outer->Contains(inner) && !inner->Contains(outer));
+    ASSERT(loopAnalysis.GetLoops().front() == outer);
+}
+
+/**
+ *  Graph:
+ *      0 -> 1, 2
+ *      1 -> 2, 3
+ *      2 -> 1
+ *      3 -> 3
+ *
+ *  Cycle 1-2 is entered both from 1 and 2, block 3 is a self loop without a pre-header
+ */
+TEST(LOOP_ANALYSIS, IrreducibleLoop)
+{
+    auto graph = ir::Graph {};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    bb0->SetTrueSuccessor(bb1);
+    bb0->SetFalseSuccessor(bb2);
+    bb1->SetTrueSuccessor(bb2);
+    bb1->SetFalseSuccessor(bb3);
+    bb2->SetTrueSuccessor(bb1);
+    bb3->SetTrueSuccessor(bb3);
+
+    LoopAnalysis loopAnalysis {&graph};
+    loopAnalysis.Run();
+
+    auto *irreducible = loopAnalysis.GetLoop(bb2);
+    ASSERT(irreducible->IsIrreducible());
+    ASSERT(irreducible->GetHeader() == bb1);
+    ASSERT(ToSet(irreducible->GetBlocks()) == BBSet({bb1, bb2}));
+    ASSERT(irreducible->GetPreHeader() == nullptr);
+    ASSERT(irreducible->GetExitBlocks() == std::vector<ir::BasicBlock *>({bb3}));
+    ASSERT(loopAnalysis.GetLoop(bb0)->IsRoot());
+
+    auto *selfLoop = loopAnalysis.GetLoop(bb3);
+    ASSERT(!selfLoop->IsIrreducible());
+    ASSERT(selfLoop->GetBlocks() == std::vector<ir::BasicBlock *>({bb3}));
+    ASSERT(selfLoop->GetBackEdges() == std::vector<ir::BasicBlock *>({bb3}));
+    ASSERT(selfLoop->GetPreHeader() == nullptr);
+    ASSERT(selfLoop->GetExitBlocks().empty());
+    ASSERT(selfLoop->GetOuterLoop()->IsRoot());
+}
+
+/**
+ *  Graph:
+ *      0 -> 1, 3
+ *      1 -> 2
+ *      2 -> 3
+ *      3 -> 2, 4
+ *      4 -> 1, 5
+ *
+ *  Cycle 2-3 is entered from 0 by 3, the cycle of 1 contains it and is entered through 3 as well
+ */
+TEST(LOOP_ANALYSIS, EntryIntoInnerLoop)
+{
+    auto graph = ir::Graph {};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+    auto *bb5 = ir::BasicBlock::Create(&graph);
+
+    bb0->SetTrueSuccessor(bb1);
+    bb0->SetFalseSuccessor(bb3);
+    bb1->SetTrueSuccessor(bb2);
+    bb2->SetTrueSuccessor(bb3);
+    bb3->SetTrueSuccessor(bb2);
+    bb3->SetFalseSuccessor(bb4);
+    bb4->SetTrueSuccessor(bb1);
+    bb4->SetFalseSuccessor(bb5);
+
+    LoopAnalysis loopAnalysis {&graph};
+    loopAnalysis.Run();
+
+    auto *outer = loopAnalysis.GetLoop(bb4);
+    ASSERT(outer->GetHeader() == bb1 && outer->IsIrreducible());
+    ASSERT(outer->GetPreHeader() == nullptr);
+    auto *inner = loopAnalysis.GetLoop(bb3);
+    ASSERT(inner->GetHeader() == bb2 && inner->IsIrreducible());
+    ASSERT(outer->Contains(inner));
+}
+
+TEST(LOOP_ANALYSIS, GeneratedGraphs)
+{
+    size_t loopsCount = 0;
+    ForEachGeneratedGraph(GetGeneratedGraphsOptions(), [&loopsCount](ir::Graph *graph) {
+        AnalysisManager analysisManager {graph};
+        auto &loopAnalysis = analysisManager.GetAnalysis<LoopAnalysis>();
+        auto &domTree = loopAnalysis.GetDominatorsTree();
+
+        size_t blocksCount = 0;
+        graph->IterateOverBlocks([&loopAnalysis, &domTree, &blocksCount](ir::BasicBlock *bb) {
+            auto *loop = loopAnalysis.GetLoop(bb);
+            ASSERT(loop != nullptr);
+            ++blocksCount;
+            // generated loops are natural, headers dominate blocks of their loops
+            for (; !loop->IsRoot(); loop = loop->GetOuterLoop()) {
+                ASSERT(!loop->IsIrreducible());
+                ASSERT(loop->GetDepth() <= 3);
+                ASSERT(domTree.DoesBlockDominatesOn(bb, loop->GetHeader()));
+            }
+            return false;
+        });
+
+        loopsCount += loopAnalysis.GetLoops().size();
+        size_t loopBlocksCount = loopAnalysis.GetRootLoop()->GetBlocks().size();
+        for (auto *loop : loopAnalysis.GetLoops()) {
+            loopBlocksCount += loop->GetBlocks().size();
+            ASSERT(loop->GetDepth() == loop->GetOuterLoop()->GetDepth() + 1);
+            for (auto *latch : loop->GetBackEdges()) {
+                ASSERT(loop->Contains(loopAnalysis.GetLoop(latch)));
+            }
+            for (auto *exitBlock : loop->GetExitBlocks()) {
+                ASSERT(!loop->Contains(loopAnalysis.GetLoop(exitBlock)));
+            }
+        }
+        ASSERT(loopBlocksCount == blocksCount);
+    });
+    ASSERT(loopsCount != 0);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "analysis/analysis.h"
+#include "analysis/loop_analysis.h"
+#include "analysis/optimization.h"
+#include "analysis/pass_manager.h"
+#include "analysis/statistics.h"
+#include "ir/call_graph.h"
+#include "ir/graph.h"
+#include "ir/graph_generator.h"
+#include "utils/macros.h"
+
+#include <algorithm>
+#include <string_view>
+
+namespace compiler::tests {
+
+namespace {
+
+size_t CountRecords(const CompilerStatistics &statistics, std::string_view passName)
+{
+    const auto &records = statistics.GetRecords();
+    return std::count_if(records.begin(), records.end(),
+                         [passName](const auto &record) { return record.passName == passName; });
+}
+
+}  // namespace
+
+TEST(PASS_MANAGER, CachedAnalyses)
+{
+    auto options = ir::GeneratorOptions {};
+    options.blocksCount = 64;
+    auto graph = ir::Graph {};
+    ir::GraphGenerator {options}.GenerateMethod(&graph);
+
+    auto analysisManager = AnalysisManager {&graph};
+    ASSERT(!analysisManager.IsValid<RPO>());
+    auto *rpo = &analysisManager.GetAnalysis<RPO>();
+    ASSERT(analysisManager.IsValid<RPO>());
+    ASSERT(!analysisManager.IsValid<DominatorsTree>());
+    ASSERT(&analysisManager.GetAnalysis<RPO>() == rpo);
+    ASSERT(rpo->GetRpoVector().size() == graph.GetBlocksCount());
+
+    analysisManager.GetAnalysis<DominatorsTree>();
+    analysisManager.Invalidate(MakeAnalysisMask<AnalysisType::DOMINATORS_TREE>());
+    ASSERT(!analysisManager.IsValid<RPO>());
+    ASSERT(analysisManager.IsValid<DominatorsTree>());
+    // analysis object is reused by the next run
+    ASSERT(&analysisManager.GetAnalysis<RPO>() == rpo);
+
+    // loops are built on the cached dominators tree
+    auto &loopAnalysis = analysisManager.GetAnalysis<LoopAnalysis>();
+    ASSERT(&loopAnalysis.GetDominatorsTree() == &analysisManager.GetAnalysis<DominatorsTree>());
+}
+
+TEST(PASS_MANAGER, Pipeline)
+{
+    auto options = ir::GeneratorOptions {};
+    options.blocksCount = 64;
+    options.methodsCount = 2;
+    options.callsPerMethod = 1;
+    auto callGraph = ir::CallGraph {};
+    auto methods = ir::GraphGenerator {options}.GenerateMethods(&callGraph);
+    auto *root = methods.front().get();
+
+    auto statistics = CompilerStatistics {};
+    root->SetStatistics(&statistics);
+    auto passManager = PassManager {root};
+    auto *analysisManager = passManager.GetAnalysisManager();
+
+    passManager.Run<InliningOptimizer>();
+    // inlining changes control flow, nothing is computed in advance
+    ASSERT(!analysisManager->IsValid<RPO>());
+    ASSERT(CountRecords(statistics, "RPO") == 0);
+
+    passManager.Run<PeepHoleOptimizer>();
+    passManager.Run<CheckOptimizer>();
+    passManager.Run<PeepHoleOptimizer>();
+    passManager.Run<CheckOptimizer>();
+    ASSERT(analysisManager->IsValid<RPO>());
+    ASSERT(analysisManager->IsValid<DominatorsTree>());
+    ASSERT(CountRecords(statistics, "RPO") == 1);
+    ASSERT(CountRecords(statistics, "DominatorsTree") == 1);
+
+    // standalone passes keep their analyses private
+    CheckOptimizer(root).Run();
+    ASSERT(CountRecords(statistics, "DominatorsTree") == 2);
+}
+
+}  // namespace compiler::tests
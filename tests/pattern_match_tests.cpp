@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "analysis/pattern_match.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+#include <cstdint>
+
+namespace compiler::tests {
+
+TEST(PATTERN_MATCH, BinaryPatterns)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateConstInt(7);
+    auto *v3 = irBuilder.CreateAdd(v2, v0);
+    auto *v4 = irBuilder.CreateShl(v2, v0);
+    auto *v5 = irBuilder.CreateXor(v3, v1);
+    auto *v6 = irBuilder.CreateCmpLT(v0, v1);
+
+    ir::Instruction *x = nullptr;
+    ir::Instruction *y = nullptr;
+    int64_t c = 0;
+    // commutative pattern matches swapped inputs
+    ASSERT(pattern::Add(pattern::Value(&x), pattern::AnyConst(&c)).Match(v3));
+    ASSERT(x == v0 && c == 7);
+    ASSERT(pattern::Add(pattern::Specific(v0), pattern::Const(7)).Match(v3));
+    ASSERT(!pattern::Add(pattern::Any(), pattern::Const(0)).Match(v3));
+    ASSERT(!pattern::Mul(pattern::Any(), pattern::Any()).Match(v3));
+
+    // shl is not commutative
+    ASSERT(!pattern::Shl(pattern::Value(&x), pattern::AnyConst(&c)).Match(v4));
+    ASSERT(pattern::Shl(pattern::AnyConst(&c), pattern::Value(&x)).Match(v4));
+
+    // nested patterns
+    ASSERT(pattern::Xor(pattern::Capture(&y, pattern::Add(pattern::Value(&x), pattern::Const(7))), pattern::Specific(v1))
+               .Match(v5));
+    ASSERT(x == v0 && y == v3);
+    ASSERT(pattern::Xor(pattern::Value(&x), pattern::Value(&y)).Match(v5));
+    ASSERT(!pattern::Xor(pattern::Value(&x), pattern::Same(&x)).Match(v5));
+
+    // comparison matches its flags and the order of inputs
+    ASSERT(pattern::Compare(ir::CmpFlags::LT, pattern::Specific(v0), pattern::Value(&x)).Match(v6));
+    ASSERT(x == v1);
+    ASSERT(!pattern::Compare(ir::CmpFlags::LE, pattern::Any(), pattern::Any()).Match(v6));
+    ASSERT(!pattern::Compare(ir::CmpFlags::LT, pattern::Specific(v1), pattern::Specific(v0)).Match(v6));
+}
+
+}  // namespace compiler::tests
@@ -4,10 +4,14 @@
 #include "ir/basic_block.h"
 #include "ir/common.h"
 #include "ir/graph.h"
+#include "ir/graph_generator.h"
 #include "ir/ir_builder.h"
 #include "ir/instruction.h"
 #include "utils/macros.h"
 
+#include <cstdint>
+#include <limits>
+
 namespace compiler::tests {
 
 /**
@@ -58,7 +62,7 @@ TEST(PEEPHOLE_OPT, AddPeepholeOneOpZero)
     ASSERT(bb1->GetAliveInstructionCount() == 1);
 
     ASSERT(v4->GetFirstOp() == v0);
-    ASSERT(v0->GetUsers() == ir::Instruction::Users {v4});
+    ASSERT(v0->CreateUsersSet() == ir::Instruction::Users {v4});
 }
 
 /**
@@ -108,7 +112,7 @@ TEST(PEEPHOLE_OPT, AddPeepholeSameValue)
 
     auto *shlInst = v3->GetFirstOp();
     [[maybe_unused]] auto *constOne = shlInst->GetLastOp();
-    ASSERT(shlInst->GetUsers() == ir::Instruction::Users {v3});
+    ASSERT(shlInst->CreateUsersSet() == ir::Instruction::Users {v3});
     ASSERT(shlInst->GetOpcode() == ir::Opcode::SHL);
     ASSERT(shlInst->GetFirstOp() == v0);
     ASSERT(constOne->GetOpcode() == ir::Opcode::CONSTANT);
@@ -163,7 +167,7 @@ TEST(PEEPHOLE_OPT, ShlPeepholeFirstOpZero)
     ASSERT(bb1->GetAliveInstructionCount() == 1);
 
     ASSERT(v4->GetFirstOp() == v1);
-    ASSERT(v1->GetUsers() == ir::Instruction::Users {v4});
+    ASSERT(v1->CreateUsersSet() == ir::Instruction::Users {v4});
 }
 
 /**
@@ -214,7 +218,7 @@ TEST(PEEPHOLE_OPT, ShlPeepholeSecondOpZero)
     ASSERT(bb1->GetAliveInstructionCount() == 1);
 
     ASSERT(v4->GetFirstOp() == v0);
-    ASSERT(v0->GetUsers() == ir::Instruction::Users {v4});
+    ASSERT(v0->CreateUsersSet() == ir::Instruction::Users {v4});
 }
 
 /**
@@ -265,7 +269,7 @@ TEST(PEEPHOLE_OPT, XorPeepholeOneOpZero)
     ASSERT(bb1->GetAliveInstructionCount() == 1);
 
     ASSERT(v4->GetFirstOp() == v0);
-    ASSERT(v0->GetUsers() == ir::Instruction::Users {v4});
+    ASSERT(v0->CreateUsersSet() == ir::Instruction::Users {v4});
 }
 
 /**
@@ -313,7 +317,7 @@ TEST(PEEPHOLE_OPT, XorPeepholeSameValue)
     ASSERT(bb1->GetAliveInstructionCount() == 1);
 
     [[maybe_unused]] auto *constZero = v3->GetFirstOp();
-    ASSERT(constZero->GetUsers() == ir::Instruction::Users {v3});
+    ASSERT(constZero->CreateUsersSet() == ir::Instruction::Users {v3});
     ASSERT(constZero->GetOpcode() == ir::Opcode::CONSTANT);
     ASSERT(constZero->As<ir::AssignInst>()->GetValue() == 0);
 }
@@ -378,7 +382,7 @@ TEST(PEEPHOLE_OPT, ConstFolding)
     ASSERT(bb1->GetAliveInstructionCount() == 1);
 
     [[maybe_unused]] auto *constEight = v7->GetFirstOp();
-    ASSERT(constEight->GetUsers() == ir::Instruction::Users {v7});
+    ASSERT(constEight->CreateUsersSet() == ir::Instruction::Users {v7});
     ASSERT(constEight->GetOpcode() == ir::Opcode::CONSTANT);
     ASSERT(constEight->As<ir::AssignInst>()->GetValue() == 8);
 }
@@ -467,8 +471,368 @@ TEST(PEEPHOLE_OPT, ConstFoldingWithPhi)
     ASSERT(bb2->GetAliveInstructionCount() == 1);
     ASSERT(bb3->GetAliveInstructionCount() == 1);
 
-    ASSERT(v1->GetUsers() == ir::Instruction::Users {v10});
+    ASSERT(v1->CreateUsersSet() == ir::Instruction::Users {v10});
     ASSERT(v10->GetInputs() == ir::Instruction::Inputs {v1});
 }
 
+/**
+ *   Source Code:
+ *       function foo(n: int): int {
+ *           let value = 0;
+ *           let result = value + 1;
+ *           while (result < n) {
+ *               value = 0 + 0;
+ *               result = value + 1;
+ *           }
+ *           return result;
+ *       }
+ *
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3. Br BB.1
+ *       BB.1:
+ *           4p.s32 Phi v1:BB.0, v9:BB.2
+ *           5.s32 Add v4p, v2
+ *           6.b Cmp LT v5, v0
+ *           7. If v6, BB.2, BB.3
+ *       BB.2:
+ *           8.s32 Add v1, v1
+ *           9. Br BB.1
+ *       BB.3:
+ *          10.s32 Return v5
+ *
+ *   Phi in the header is processed before the latch, so it is optimized only after users of v8 are revisited:
+ *       BB.1:
+ *           6.b Cmp LT v11, v0
+ *           7. If v6, BB.2, BB.3
+ *       BB.2:
+ *           9. Br BB.1
+ *       BB.3:
+ *          10.s32 Return v11
+ *   where v11 is Constant 1 in BB.0
+ */
+TEST(PEEPHOLE_OPT, ConstFoldingInLoopHeader)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    [[maybe_unused]] auto *v3 = irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v5 = irBuilder.CreateAdd(v4, v2);
+    auto *v6 = irBuilder.CreateCmpLT(v5, v0);
+    [[maybe_unused]] auto *v7 = irBuilder.CreateCondBr(v6, bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v8 = irBuilder.CreateAdd(v1, v1);
+    [[maybe_unused]] auto *v9 = irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v10 = irBuilder.CreateRet(v5);
+
+    v4->ResolveDependency(v1, bb0);
+    v4->ResolveDependency(v8, bb2);
+
+    PeepHoleOptimizer peepHoleOpt(&graph);
+    ASSERT(peepHoleOpt.Run());
+
+    ASSERT(bb1->GetAliveInstructionCount() == 2);
+    ASSERT(bb2->GetAliveInstructionCount() == 1);
+    auto *v11 = v10->GetFirstOp();
+    ASSERT(v11->GetOpcode() == ir::Opcode::CONSTANT);
+    ASSERT(v11->As<ir::AssignInst>()->GetValue() == 1);
+    ASSERT(v6->GetFirstOp() == v11);
+
+    // fixpoint is reached by a single run
+    ASSERT(!peepHoleOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3. Br BB.1
+ *       BB.1:
+ *           4.s32 Mul v2, v0
+ *           5.s32 Mul v4, v1
+ *           6.s32 Return v4
+ *           7.s32 Return v5
+ *
+ *   After peephole optimizer:
+ *       BB.1:
+ *           6.s32 Return v0
+ *           7.s32 Return v1
+ */
+TEST(PEEPHOLE_OPT, MulPeepholeIdentities)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreateMul(v2, v0);
+    auto *v5 = irBuilder.CreateMul(v4, v1);
+    auto *v6 = irBuilder.CreateRet(v4);
+    auto *v7 = irBuilder.CreateRet(v5);
+
+    PeepHoleOptimizer peepHoleOpt(&graph);
+    ASSERT(peepHoleOpt.Run());
+
+    ASSERT(bb1->GetAliveInstructionCount() == 2);
+    ASSERT(v6->GetFirstOp() == v0);
+    ASSERT(v7->GetFirstOp()->GetOpcode() == ir::Opcode::CONSTANT);
+    ASSERT(v7->GetFirstOp()->As<ir::AssignInst>()->GetValue() == 0);
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 3
+ *           2.s32 Constant 5
+ *           3. Br BB.1
+ *       BB.1:
+ *           4.s32 Add v1, v0
+ *           5.s32 Add v2, v4
+ *           6.s32 Xor v5, v0
+ *           7.s32 Xor v6, v0
+ *           8.s32 Return v7
+ *
+ *   After peephole optimizer:
+ *       BB.1:
+ *           5.s32 Add v0, v9    (v9 is Constant 8)
+ *           8.s32 Return v5
+ */
+TEST(PEEPHOLE_OPT, ReassociationAndXorOfXor)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(3);
+    auto *v2 = irBuilder.CreateConstInt(5);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreateAdd(v1, v0);
+    auto *v5 = irBuilder.CreateAdd(v2, v4);
+    auto *v6 = irBuilder.CreateXor(v5, v0);
+    auto *v7 = irBuilder.CreateXor(v6, v0);
+    auto *v8 = irBuilder.CreateRet(v7);
+
+    PeepHoleOptimizer peepHoleOpt(&graph);
+    ASSERT(peepHoleOpt.Run());
+
+    // dead v4 and v6 are kept, peephole does not remove unused instructions
+    ASSERT(v8->GetFirstOp() == v5);
+    ASSERT(v5->GetFirstOp() == v0);
+    ASSERT(v5->GetLastOp()->GetOpcode() == ir::Opcode::CONSTANT);
+    ASSERT(v5->GetLastOp()->As<ir::AssignInst>()->GetValue() == 8);
+    // constant operand of v4 is moved to the right
+    ASSERT(v4->GetFirstOp() == v0 && v4->GetLastOp() == v1);
+    ASSERT(!peepHoleOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 8
+ *           2.s32 Constant 10
+ *           3.s32 Constant 7
+ *           4.s32 Constant -2147483648
+ *           5. Br BB.1
+ *       BB.1:
+ *           6.s32 Mul v0, v1
+ *           7.s32 Mul v0, v2
+ *           8.s32 Mul v0, v3
+ *           9.s32 Mul v4, v0
+ *          10.s32 Return v6
+ *          11.s32 Return v7
+ *          12.s32 Return v8
+ *          13.s32 Return v9
+ *
+ *   After peephole optimizer:
+ *       BB.1:
+ *           6.s32 Shl v0, 3
+ *           a.s32 Shl v0, 3
+ *           b.s32 Shl v0, 1
+ *           7.s32 Add va, vb
+ *           8.s32 Mul v0, v3
+ *           9.s32 Shl v0, 31
+ *          10.s32 Return v6
+ *          11.s32 Return v7
+ *          12.s32 Return v8
+ *          13.s32 Return v9
+ */
+TEST(PEEPHOLE_OPT, MulStrengthReduction)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(8);
+    auto *v2 = irBuilder.CreateConstInt(10);
+    auto *v3 = irBuilder.CreateConstInt(7);
+    auto *v4 = irBuilder.CreateConstInt(std::numeric_limits<int32_t>::min());
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v10 = irBuilder.CreateRet(irBuilder.CreateMul(v0, v1));
+    auto *v11 = irBuilder.CreateRet(irBuilder.CreateMul(v0, v2));
+    auto *v12 = irBuilder.CreateRet(irBuilder.CreateMul(v0, v3));
+    auto *v13 = irBuilder.CreateRet(irBuilder.CreateMul(v4, v0));
+
+    PeepHoleOptimizer peepHoleOpt(&graph);
+    ASSERT(peepHoleOpt.Run());
+
+    auto isShl = [v0](ir::Instruction *inst, int64_t shift) {
+        return inst->GetOpcode() == ir::Opcode::SHL && inst->GetFirstOp() == v0 &&
+               inst->GetLastOp()->As<ir::AssignInst>()->GetValue() == shift;
+    };
+    ASSERT(isShl(v10->GetFirstOp(), 3));
+    auto *v7 = v11->GetFirstOp();
+    ASSERT(v7->GetOpcode() == ir::Opcode::ADD);
+    ASSERT(isShl(v7->GetFirstOp(), 3) && isShl(v7->GetLastOp(), 1));
+    // three shifts are not cheaper than multiplication
+    ASSERT(v12->GetFirstOp()->GetOpcode() == ir::Opcode::MUL);
+    // only the low 32 bits of the sign extended constant are taken into account
+    ASSERT(isShl(v13->GetFirstOp(), 31));
+    ASSERT(!peepHoleOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 65536
+ *           2.s32 Constant 2147483647
+ *           3.s32 Constant 1
+ *           4.s32 Constant 31
+ *          21.s32 Constant 65539
+ *           5.u8 Constant 200
+ *           6.u8 Constant 100
+ *           7. Br BB.1
+ *       BB.1:
+ *           8.s32 Mul v1, v1
+ *           9.s32 Add v2, v3
+ *          10.s32 Shl v3, v4
+ *          11.u8 Add v5, v6
+ *          12.u8 Mul v5, v6
+ *          13.s32 Mul v0, v21
+ *          14.s32 Mul v13, v21
+ *          15.s32 Return v8
+ *          16.s32 Return v9
+ *          17.s32 Return v10
+ *          18.u8 Return v11
+ *          19.u8 Return v12
+ *          20.s32 Return v14
+ *
+ *   After peephole optimizer:
+ *       folded values wrap around to the width of their type: v8 is 0, v9 and v10 are -2147483648, v11 is 44 and
+ *       v12 is 32. v14 is reassociated to `v0 * 393225`, the low 32 bits of 65539 * 65539
+ */
+TEST(PEEPHOLE_OPT, OverflowFolding)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(65536);
+    auto *v2 = irBuilder.CreateConstInt(std::numeric_limits<int32_t>::max());
+    auto *v3 = irBuilder.CreateConstInt(1);
+    auto *v4 = irBuilder.CreateConstInt(31);
+    auto *v21 = irBuilder.CreateConstInt(65539);
+    // builder creates s32 constants only
+    auto createU8Const = [&graph, bb0](int64_t value) {
+        auto *constInst = graph.GetAllocator()->New<ir::AssignInst>(bb0, ir::InstId {graph.NewInstId()},
+                                                                    ir::Opcode::CONSTANT, ir::ResultType::U8, value);
+        bb0->InsertInstBack(constInst);
+        graph.RegisterConstant(constInst);
+        return constInst;
+    };
+    auto *v5 = createU8Const(200);
+    auto *v6 = createU8Const(100);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v15 = irBuilder.CreateRet(irBuilder.CreateMul(v1, v1));
+    auto *v16 = irBuilder.CreateRet(irBuilder.CreateAdd(v2, v3));
+    auto *v17 = irBuilder.CreateRet(irBuilder.CreateShl(v3, v4));
+    auto *v18 = irBuilder.CreateRet(irBuilder.CreateAdd(v5, v6));
+    auto *v19 = irBuilder.CreateRet(irBuilder.CreateMul(v5, v6));
+    auto *v20 = irBuilder.CreateRet(irBuilder.CreateMul(irBuilder.CreateMul(v0, v21), v21));
+
+    PeepHoleOptimizer peepHoleOpt(&graph);
+    ASSERT(peepHoleOpt.Run());
+
+    auto isConst = [](ir::Instruction *inst, ir::ResultType resType, int64_t value) {
+        return inst->GetOpcode() == ir::Opcode::CONSTANT && inst->GetResultType() == resType &&
+               inst->As<ir::AssignInst>()->GetValue() == value;
+    };
+    constexpr auto S32Min = int64_t {std::numeric_limits<int32_t>::min()};
+    ASSERT(isConst(v15->GetFirstOp(), ir::ResultType::S32, 0));
+    ASSERT(isConst(v16->GetFirstOp(), ir::ResultType::S32, S32Min));
+    ASSERT(isConst(v17->GetFirstOp(), ir::ResultType::S32, S32Min));
+    ASSERT(isConst(v18->GetFirstOp(), ir::ResultType::U8, 44));
+    ASSERT(isConst(v19->GetFirstOp(), ir::ResultType::U8, 32));
+    auto *v14 = v20->GetFirstOp();
+    ASSERT(v14->GetOpcode() == ir::Opcode::MUL && v14->GetFirstOp() == v0);
+    ASSERT(isConst(v14->GetLastOp(), ir::ResultType::S32, 393225));
+    ASSERT(!peepHoleOpt.Run());
+}
+
+TEST(PEEPHOLE_OPT, FixpointOnGeneratedGraphs)
+{
+    for (uint64_t seed = 0; seed < 20; ++seed) {
+        auto options = ir::GeneratorOptions {};
+        options.seed = seed;
+        options.blocksCount = 100;
+        options.maxLoopDepth = 3;
+        options.loopProbability = 0.4;
+        options.phisCount = 2;
+
+        auto graph = ir::Graph {};
+        ir::GraphGenerator {options}.GenerateMethod(&graph);
+        PeepHoleOptimizer peepHoleOpt(&graph);
+        peepHoleOpt.Run();
+        ASSERT(!peepHoleOpt.Run());
+    }
+}
+
 }  // namespace compiler::tests
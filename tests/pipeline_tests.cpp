@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "analysis/pipeline.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/graph_generator.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+#include <sstream>
+
+namespace compiler::tests {
+
+namespace {
+
+size_t CountInstructions(ir::Graph *graph, ir::Opcode opcode)
+{
+    size_t count = 0;
+    graph->IterateOverBlocks([&count, opcode](ir::BasicBlock *bb) {
+        bb->IterateOverInstructions([&count, opcode](ir::Instruction *inst) {
+            count += inst->GetOpcode() == opcode ? 1 : 0;
+            return false;
+        });
+    });
+    return count;
+}
+
+std::string Dump(ir::Graph *graph)
+{
+    std::stringstream ss;
+    graph->Dump(ss);
+    return ss.str();
+}
+
+}  // namespace
+
+TEST(PIPELINE, OptLevels)
+{
+    auto options = ir::GeneratorOptions {};
+    options.seed = 3;
+    options.blocksCount = 48;
+    options.methodsCount = 2;
+    options.callsPerMethod = 2;
+    options.memoryProbability = 0.5;
+
+    for (auto level : {OptLevel::O0, OptLevel::O1, OptLevel::O2}) {
+        auto callGraph = ir::CallGraph {};
+        auto methods = ir::GraphGenerator {options}.GenerateMethods(&callGraph);
+        auto *root = methods.front().get();
+        auto dumpBefore = Dump(root);
+        auto checksCount = CountInstructions(root, ir::Opcode::CHECK);
+        auto statistics = CompilerStatistics {};
+        root->SetStatistics(&statistics);
+
+        auto changedCount = CompileMethod(root, level);
+        switch (level) {
+            case OptLevel::O0:
+                ASSERT(changedCount == 0);
+                ASSERT(Dump(root) == dumpBefore);
+                break;
+            case OptLevel::O1:
+                ASSERT(changedCount == 1);
+                ASSERT(CountInstructions(root, ir::Opcode::CALL_STATIC) == options.callsPerMethod);
+                ASSERT(CountInstructions(root, ir::Opcode::CHECK) == checksCount);
+                break;
+            case OptLevel::O2:
+                ASSERT(CountInstructions(root, ir::Opcode::CALL_STATIC) == 0);
+                // inlined callees bring their own checks, so eliminated ones are counted
+                ASSERT(statistics.GetTotalCounter(StatCounter::ELIMINATED_CHECKS) != 0);
+                // the pipeline stops at fixpoint
+                ASSERT(CompileMethod(root, level) == 0);
+                break;
+            default:
+                UNREACHABLE();
+        }
+    }
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include "analysis/pass_manager.h"
+#include "analysis/range_analysis.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "tests/generated_graphs.h"
+#include "utils/macros.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.u8 Parameter 0
+ *           1.s32 Parameter 1
+ *           2.s32 Constant 4
+ *           3.s32 Constant 2
+ *           4.s32 Mul v0, v2
+ *           5.s32 Add v4, v3
+ *           6.s32 Shl v5, v3
+ *           7.s32 Mul v1, v2
+ *           8.s32 Add v1, v0
+ *           9.s32 Return v6
+ */
+TEST(RANGE_ANALYSIS, Arithmetic)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::U8, 0);
+    auto *v1 = irBuilder.CreateParam(ir::ResultType::S32, 1);
+    auto *v2 = irBuilder.CreateConstInt(4);
+    auto *v3 = irBuilder.CreateConstInt(2);
+    auto *v4 = irBuilder.CreateMul(v0, v2);
+    auto *v5 = irBuilder.CreateAdd(v4, v3);
+    auto *v6 = irBuilder.CreateShl(v5, v3);
+    auto *v7 = irBuilder.CreateMul(v1, v2);
+    auto *v8 = irBuilder.CreateAdd(v1, v0);
+    irBuilder.CreateRet(v6);
+
+    AnalysisManager analysisManager {&graph};
+    RangeAnalysis rangeAnalysis {&graph, &analysisManager};
+    rangeAnalysis.Run();
+
+    ASSERT(rangeAnalysis.GetRange(v0) == ValueRange({0, 255}));
+    ASSERT(rangeAnalysis.GetRange(v2) == ValueRange({4, 4}));
+    ASSERT(rangeAnalysis.GetRange(v4) == ValueRange({0, 1020}));
+    ASSERT(rangeAnalysis.GetRange(v5) == ValueRange({2, 1022}));
+    ASSERT(rangeAnalysis.GetRange(v6) == ValueRange({8, 4088}));
+    // results may overflow s32
+    ASSERT(rangeAnalysis.GetRange(v7) == ValueRange::Full());
+    ASSERT(rangeAnalysis.GetRange(v8) == ValueRange::Full());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3.s32 Constant 10
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v1:BB.0, v8:BB.2
+ *           6.b CmpLT v5, v3
+ *           7. CondBr v6, BB.2, BB.3
+ *       BB.2:
+ *           8.s32 Add v5, v2
+ *           9. Br BB.1
+ *       BB.3:
+ *          10.b CmpLE v0, v5
+ *          11. CondBr v10, BB.4, BB.5
+ *       BB.4:
+ *          12.s32 Return v0
+ *       BB.5:
+ *          13.s32 Return v5
+ */
+TEST(RANGE_ANALYSIS, LoopConditions)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+    auto *bb5 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateConstInt(10);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v5, v3), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v8 = irBuilder.CreateAdd(v5, v2);
+    irBuilder.CreateBr(bb1);
+    v5->ResolveDependency(v1, bb0);
+    v5->ResolveDependency(v8, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLE(v0, v5), bb4, bb5);
+
+    irBuilder.SetInsertionPoint(bb4);
+    irBuilder.CreateRet(v0);
+
+    irBuilder.SetInsertionPoint(bb5);
+    irBuilder.CreateRet(v5);
+
+    AnalysisManager analysisManager {&graph};
+    RangeAnalysis rangeAnalysis {&graph, &analysisManager};
+    rangeAnalysis.Run();
+
+    // the phi is the induction variable of the loop with 10 iterations
+    constexpr auto S32Max = int64_t {std::numeric_limits<int32_t>::max()};
+    ASSERT(rangeAnalysis.GetRange(v5) == ValueRange({0, 10}));
+    ASSERT(rangeAnalysis.GetRange(v8) == ValueRange({1, 10}));
+    ASSERT(rangeAnalysis.GetRange(v5, bb2) == ValueRange({0, 9}));
+    ASSERT(rangeAnalysis.GetRange(v5, bb3) == ValueRange({10, 10}));
+
+    // conditions of dominating branches are combined, the other operand of a compare is not narrowed
+    ASSERT(rangeAnalysis.GetRange(v0, bb4) == ValueRange({std::numeric_limits<int32_t>::min(), 10}));
+    ASSERT(rangeAnalysis.GetRange(v5, bb4) == ValueRange({10, 10}));
+    ASSERT(rangeAnalysis.GetRange(v0, bb5) == ValueRange({1, S32Max}));
+    ASSERT(rangeAnalysis.GetRange(v5, bb5) == ValueRange({10, 10}));
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3. Br BB.1
+ *       BB.1:
+ *           4p.s32 Phi v1:BB.0, v7:BB.2
+ *           5.b CmpLT v4, v0
+ *           6. CondBr v5, BB.2, BB.3
+ *       BB.2:
+ *           7.s32 Add v4, v2
+ *           8. Br BB.1
+ *       BB.3:
+ *           9.s32 Return v4
+ */
+TEST(RANGE_ANALYSIS, Widening)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v4, v0), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v7 = irBuilder.CreateAdd(v4, v2);
+    irBuilder.CreateBr(bb1);
+    v4->ResolveDependency(v1, bb0);
+    v4->ResolveDependency(v7, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateRet(v4);
+
+    AnalysisManager analysisManager {&graph};
+    RangeAnalysis rangeAnalysis {&graph, &analysisManager};
+    rangeAnalysis.Run();
+
+    // the trip count is unknown, so the phi is widened to its type and the loop condition keeps the increment from
+    // overflow
+    constexpr auto S32Max = int64_t {std::numeric_limits<int32_t>::max()};
+    ASSERT(rangeAnalysis.GetRange(v4) == ValueRange({0, S32Max}));
+    ASSERT(rangeAnalysis.GetRange(v7) == ValueRange({1, S32Max}));
+    ASSERT(rangeAnalysis.GetRange(v4, bb2) == ValueRange({0, S32Max - 1}));
+}
+
+TEST(RANGE_ANALYSIS, GeneratedGraphs)
+{
+    size_t narrowedPhisCount = 0;
+    auto options = GetGeneratedGraphsOptions();
+    options.memoryProbability = 0.5;
+    ForEachGeneratedGraph(options, [&narrowedPhisCount](ir::Graph *graph) {
+        AnalysisManager analysisManager {graph};
+        RangeAnalysis rangeAnalysis {graph, &analysisManager};
+        rangeAnalysis.Run();
+
+        // ranges are the fixed point, phis contain values which come from all predecessors
+        for (auto *bb : analysisManager.GetAnalysis<RPO>().GetRpoVector()) {
+            bb->IterateOverInstructions([&rangeAnalysis, &narrowedPhisCount](ir::Instruction *inst) {
+                if (inst->GetOpcode() != ir::Opcode::PHI) {
+                    return true;
+                }
+                auto *phi = inst->As<ir::PhiInst>();
+                for (size_t idx = 0; idx < phi->GetInputs().Size(); ++idx) {
+                    auto inputRange = rangeAnalysis.GetRange(phi->GetInput(idx), phi->GetIncomingBlock(idx));
+                    ASSERT(inputRange.IsInside(rangeAnalysis.GetRange(phi)));
+                }
+                if (rangeAnalysis.GetRange(phi) != ValueRange::OfType(phi->GetResultType())) {
+                    ++narrowedPhisCount;
+                }
+                return false;
+            });
+        }
+    });
+    ASSERT(narrowedPhisCount != 0);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include "analysis/analysis.h"
+#include "analysis/optimization.h"
+#include "analysis/pipeline.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "tests/generated_graphs.h"
+#include "utils/macros.h"
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 1
+ *           2.s32 Constant 2
+ *           3.s32 Constant 5
+ *           4. Br BB.1
+ *       BB.1:
+ *           5.s32 Add v1, v2
+ *           6.b CmpLT v5, v3
+ *           7. CondBr v6, BB.2, BB.3
+ *       BB.2:
+ *           8.s32 Add v0, v1
+ *           9. Br BB.4
+ *       BB.3:
+ *          10.s32 Xor v0, v2
+ *          11. Br BB.4
+ *       BB.4:
+ *          12p.s32 Phi v8:BB.2, v10:BB.3
+ *          13.s32 Return v12
+ *
+ *   After SCCP:
+ *       v5 and v6 are constants, BB.1 jumps to BB.2 unconditionally, BB.3 is removed and v12 has a single input
+ */
+TEST(SCCP_OPT, ConstantBranch)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(1);
+    auto *v2 = irBuilder.CreateConstInt(2);
+    auto *v3 = irBuilder.CreateConstInt(5);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreateAdd(v1, v2);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v5, v3), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v8 = irBuilder.CreateAdd(v0, v1);
+    irBuilder.CreateBr(bb4);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v10 = irBuilder.CreateXor(v0, v2);
+    irBuilder.CreateBr(bb4);
+
+    irBuilder.SetInsertionPoint(bb4);
+    auto *v12 = irBuilder.CreatePhi(ir::ResultType::S32);
+    v12->ResolveDependency(v8, bb2);
+    v12->ResolveDependency(v10, bb3);
+    irBuilder.CreateRet(v12);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    SCCPOptimizer sccpOpt(&graph);
+    ASSERT(sccpOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::FOLDED_CONSTANTS) == 2);
+    ASSERT(statistics.GetTotalCounter(StatCounter::FOLDED_BRANCHES) == 1);
+    ASSERT(statistics.GetTotalCounter(StatCounter::REMOVED_BLOCKS) == 1);
+    ASSERT(graph.GetBlocksCount() == 4);
+    ASSERT(bb1->GetLastInstruction()->GetOpcode() == ir::Opcode::BRANCH);
+    ASSERT(bb1->GetTrueSuccessor() == bb2 && bb1->GetFalseSuccessor() == nullptr);
+    ASSERT(bb4->GetPredecessors() == ir::BasicBlock::Predecessors {bb2});
+    ASSERT(v12->GetInputs().Size() == 1 && v12->GetInput(0) == v8);
+    ASSERT(!sccpOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 65536
+ *           2.s32 Constant 10
+ *           3. Br BB.1
+ *       BB.1:
+ *           4.s32 Mul v1, v1
+ *           5.b CmpLT v4, v2
+ *           6. CondBr v5, BB.2, BB.3
+ *       BB.2:
+ *           7.s32 Add v0, v2
+ *           8. Br BB.4
+ *       BB.3:
+ *           9.s32 Xor v0, v2
+ *          10. Br BB.4
+ *       BB.4:
+ *          11p.s32 Phi v7:BB.2, v9:BB.3
+ *          12.s32 Return v11
+ *
+ *   After SCCP:
+ *       v4 wraps around to 0, so BB.1 jumps to BB.2 unconditionally and BB.3 is removed
+ */
+TEST(SCCP_OPT, OverflowingBranch)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+    auto *bb4 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(65536);
+    auto *v2 = irBuilder.CreateConstInt(10);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v4 = irBuilder.CreateMul(v1, v1);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v4, v2), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v7 = irBuilder.CreateAdd(v0, v2);
+    irBuilder.CreateBr(bb4);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v9 = irBuilder.CreateXor(v0, v2);
+    irBuilder.CreateBr(bb4);
+
+    irBuilder.SetInsertionPoint(bb4);
+    auto *v11 = irBuilder.CreatePhi(ir::ResultType::S32);
+    v11->ResolveDependency(v7, bb2);
+    v11->ResolveDependency(v9, bb3);
+    irBuilder.CreateRet(v11);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    SCCPOptimizer sccpOpt(&graph);
+    ASSERT(sccpOpt.Run());
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::FOLDED_BRANCHES) == 1);
+    ASSERT(bb1->GetLastInstruction()->GetOpcode() == ir::Opcode::BRANCH);
+    ASSERT(bb1->GetTrueSuccessor() == bb2 && bb1->GetFalseSuccessor() == nullptr);
+    ASSERT(v11->GetInputs().Size() == 1 && v11->GetInput(0) == v7);
+    ASSERT(!sccpOpt.Run());
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2. Br BB.1
+ *       BB.1:
+ *           3p.s32 Phi v1:BB.0, v4:BB.1
+ *           4.s32 Xor v3, v0
+ *           5.s32 Xor v4, v0
+ *           6.b CmpLT v5, v0
+ *           7. CondBr v6, BB.1, BB.2
+ *       BB.2:
+ *           8.s32 Return v3
+ *
+ *   v4 is not constant, the loop stays. In the second graph v4 is `Add v3, v1`, so phi v3 is always 0:
+ *   the cycle is resolved optimistically, while peepholes see different inputs of the phi
+ */
+TEST(SCCP_OPT, LoopPhi)
+{
+    for (auto isConstant : {false, true}) {
+        auto graph = ir::Graph {};
+        auto irBuilder = ir::IRBuilder {&graph};
+
+        auto *bb0 = ir::BasicBlock::Create(&graph);
+        auto *bb1 = ir::BasicBlock::Create(&graph);
+        auto *bb2 = ir::BasicBlock::Create(&graph);
+
+        irBuilder.SetInsertionPoint(bb0);
+        auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+        auto *v1 = irBuilder.CreateConstInt(0);
+        irBuilder.CreateBr(bb1);
+
+        irBuilder.SetInsertionPoint(bb1);
+        auto *v3 = irBuilder.CreatePhi(ir::ResultType::S32);
+        auto *v4 = isConstant ? irBuilder.CreateAdd(v3, v1) : irBuilder.CreateXor(v3, v0);
+        v3->ResolveDependency(v1, bb0);
+        v3->ResolveDependency(v4, bb1);
+        auto *v5 = irBuilder.CreateXor(v4, v0);
+        irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v5, v0), bb1, bb2);
+
+        irBuilder.SetInsertionPoint(bb2);
+        auto *v8 = irBuilder.CreateRet(v3);
+
+        auto isChanged = SCCPOptimizer(&graph).Run();
+        ASSERT(isChanged == isConstant);
+        ASSERT(graph.GetBlocksCount() == 3);
+        ASSERT((v8->GetFirstOp() == v1) == isConstant);
+    }
+}
+
+/**
+ *   callee(a0):                      caller():
+ *       BB.0:                            BB.0:
+ *           0.s32 Parameter 0                0.s32 Constant 3
+ *           1.s32 Constant 10                1. Br BB.1
+ *           2. Br BB.1                   BB.1:
+ *       BB.1:                                2.s32 CallStatic callee v0
+ *           3.b CmpLT v0, v1                 3.s32 Return v2
+ *           4. CondBr v3, BB.2, BB.3
+ *       BB.2:
+ *           5.s32 Return v1
+ *       BB.3:
+ *           6.s32 Shl v0, v1
+ *           7.s32 Return v6
+ *
+ *   After O2 the inlined callee is specialized by the constant argument and the caller returns constant 10
+ */
+TEST(SCCP_OPT, InlinedConstantArgument)
+{
+    auto callGraph = ir::CallGraph {};
+    auto callee = ir::Graph {&callGraph, "callee"};
+    auto caller = ir::Graph {&callGraph, "caller"};
+    {
+        auto irBuilder = ir::IRBuilder {&callee};
+        auto *bb0 = ir::BasicBlock::Create(&callee);
+        auto *bb1 = ir::BasicBlock::Create(&callee);
+        auto *bb2 = ir::BasicBlock::Create(&callee);
+        auto *bb3 = ir::BasicBlock::Create(&callee);
+        irBuilder.SetInsertionPoint(bb0);
+        auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+        auto *v1 = irBuilder.CreateConstInt(10);
+        irBuilder.CreateBr(bb1);
+        irBuilder.SetInsertionPoint(bb1);
+        irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v0, v1), bb2, bb3);
+        irBuilder.SetInsertionPoint(bb2);
+        irBuilder.CreateRet(v1);
+        irBuilder.SetInsertionPoint(bb3);
+        irBuilder.CreateRet(irBuilder.CreateShl(v0, v1));
+    }
+    ir::Instruction *v3 = nullptr;
+    {
+        auto irBuilder = ir::IRBuilder {&caller};
+        auto *bb0 = ir::BasicBlock::Create(&caller);
+        auto *bb1 = ir::BasicBlock::Create(&caller);
+        irBuilder.SetInsertionPoint(bb0);
+        auto *v0 = irBuilder.CreateConstInt(3);
+        irBuilder.CreateBr(bb1);
+        irBuilder.SetInsertionPoint(bb1);
+        v3 = irBuilder.CreateRet(irBuilder.CreateCallStatic(callee.GetMethodId(), ir::ResultType::S32, {v0}));
+    }
+
+    auto statistics = CompilerStatistics {};
+    caller.SetStatistics(&statistics);
+    CompileMethod(&caller, OptLevel::O2);
+
+    ASSERT(statistics.GetTotalCounter(StatCounter::FOLDED_BRANCHES) == 1);
+    ASSERT(v3->GetFirstOp()->GetOpcode() == ir::Opcode::CONSTANT);
+    ASSERT(v3->GetFirstOp()->As<ir::AssignInst>()->GetValue() == 10);
+}
+
+TEST(SCCP_OPT, GeneratedGraphs)
+{
+    auto statistics = CompilerStatistics {};
+    auto options = GetGeneratedGraphsOptions();
+    options.phisCount = 2;
+    ForEachGeneratedGraph(options, [&statistics](ir::Graph *graph) {
+        graph->SetStatistics(&statistics);
+        RunToFixpoint<SCCPOptimizer>(graph);
+        // every block left is reachable
+        auto rpo = RPO {graph};
+        rpo.Run();
+        ASSERT(rpo.GetRpoVector().size() == graph->GetBlocksCount());
+    });
+    ASSERT(statistics.GetTotalCounter(StatCounter::FOLDED_CONSTANTS) != 0);
+    ASSERT(statistics.GetTotalCounter(StatCounter::FOLDED_BRANCHES) != 0);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "analysis/optimization.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/call_graph.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace compiler::tests {
+
+/**
+ *   callee(a0):                  caller(a0):
+ *       BB.0:                        BB.0:
+ *           0.s32 Parameter 0            0.s32 Parameter 0
+ *           1. Br BB.1                   1.s32 Constant 1
+ *       BB.1:                            2.s32 Constant 2
+ *           2.s32 Add v0, v0             3.s32 Constant 10
+ *           3.s32 Return v2              4. Br BB.1
+ *                                    BB.1:
+ *                                        5.s32 Add v1, v2
+ *                                        6.u32 Mem v3
+ *                                        7. Check Nil v6
+ *                                        8. Check Nil v6
+ *                                        9.s32 CallStatic callee v5
+ *                                       10.s32 Return v9
+ */
+TEST(STATISTICS, PipelineRecords)
+{
+    auto callGraph = ir::CallGraph {};
+    auto callee = ir::Graph {&callGraph, "callee"};
+    auto caller = ir::Graph {&callGraph, "caller"};
+    {
+        auto irBuilder = ir::IRBuilder {&callee};
+        auto *bb0 = ir::BasicBlock::Create(&callee);
+        auto *bb1 = ir::BasicBlock::Create(&callee);
+        irBuilder.SetInsertionPoint(bb0);
+        auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+        irBuilder.CreateBr(bb1);
+        irBuilder.SetInsertionPoint(bb1);
+        irBuilder.CreateRet(irBuilder.CreateAdd(v0, v0));
+    }
+    {
+        auto irBuilder = ir::IRBuilder {&caller};
+        auto *bb0 = ir::BasicBlock::Create(&caller);
+        auto *bb1 = ir::BasicBlock::Create(&caller);
+        irBuilder.SetInsertionPoint(bb0);
+        irBuilder.CreateParam(ir::ResultType::S32, 0);
+        auto *v1 = irBuilder.CreateConstInt(1);
+        auto *v2 = irBuilder.CreateConstInt(2);
+        auto *v3 = irBuilder.CreateConstInt(10);
+        irBuilder.CreateBr(bb1);
+        irBuilder.SetInsertionPoint(bb1);
+        auto *v5 = irBuilder.CreateAdd(v1, v2);
+        auto *v6 = irBuilder.CreateMemory(ir::ResultType::U32, v3);
+        irBuilder.CreateNullCheck(v6);
+        irBuilder.CreateNullCheck(v6);
+        auto *v9 = irBuilder.CreateCallStatic(callee.GetMethodId(), ir::ResultType::S32, {v5});
+        irBuilder.CreateRet(v9);
+    }
+
+    auto statistics = CompilerStatistics {};
+    caller.SetStatistics(&statistics);
+    InliningOptimizer(&caller).Run();
+    PeepHoleOptimizer(&caller).Run();
+    CheckOptimizer(&caller).Run();
+
+    const auto &records = statistics.GetRecords();
+    auto findRecord = [&records](std::string_view passName) {
+        return std::find_if(records.begin(), records.end(),
+                            [passName](const auto &record) { return record.passName == passName; });
+    };
+    auto inliningIt = findRecord("InliningOptimizer");
+    auto peepholeIt = findRecord("PeepHoleOptimizer");
+    auto checksIt = findRecord("CheckOptimizer");
+    ASSERT(inliningIt != records.end() && peepholeIt != records.end() && checksIt != records.end());
+    ASSERT(inliningIt < peepholeIt && peepholeIt < checksIt);
+    ASSERT(inliningIt->methodName == "caller");
+    ASSERT(inliningIt->depth == 0);
+    ASSERT(inliningIt->GetCounter(StatCounter::INLINED_CALLS) == 1);
+    ASSERT(inliningIt->blocksAfter > inliningIt->blocksBefore);
+    ASSERT(inliningIt->allocatedBytes != 0);
+    // inlined add of v5 is folded after v5 itself
+    ASSERT(peepholeIt->GetCounter(StatCounter::FOLDED_CONSTANTS) == 2);
+    ASSERT(checksIt->GetCounter(StatCounter::ELIMINATED_CHECKS) == 1);
+    ASSERT(checksIt->instsAfter + 1 == checksIt->instsBefore);
+
+    // analyses run by passes are nested into them
+    auto domTreeIt = findRecord("DominatorsTree");
+    ASSERT(domTreeIt != records.end() && domTreeIt > checksIt && domTreeIt->depth == 1);
+    ASSERT(statistics.GetTotalCounter(StatCounter::INLINED_CALLS) == 1);
+    ASSERT(statistics.GetTotalCounter(StatCounter::ELIMINATED_CHECKS, "PeepHoleOptimizer") == 0);
+
+    std::stringstream ss;
+    statistics.DumpJson(ss);
+    ASSERT(ss.str().find("\"pass\": \"InliningOptimizer\", \"method\": \"caller\", \"depth\": 0") !=
+           std::string::npos);
+    ASSERT(ss.str().find("\"inlined_calls\": 1") != std::string::npos);
+
+    // collection stops when statistics are detached
+    auto recordsCount = records.size();
+    caller.SetStatistics(nullptr);
+    PeepHoleOptimizer(&caller).Run();
+    ASSERT(statistics.GetRecords().size() == recordsCount);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include "analysis/optimization.h"
+#include "analysis/statistics.h"
+#include "ir/basic_block.h"
+#include "ir/common.h"
+#include "ir/graph.h"
+#include "ir/ir_builder.h"
+#include "ir/instruction.h"
+#include "utils/macros.h"
+
+namespace compiler::tests {
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3.s32 Constant 10
+ *           4.s32 Constant 4
+ *           5.s32 Constant 2
+ *           6. Br BB.1
+ *       BB.1:
+ *           7p.s32 Phi v1:BB.0, v15:BB.2
+ *           8p.s32 Phi v1:BB.0, v14:BB.2
+ *           9.b CmpLT v7, v3
+ *          10. CondBr v9, BB.2, BB.3
+ *       BB.2:
+ *          11.s32 Mul v7, v4
+ *          12.s32 Shl v7, v5
+ *          13.s32 Add v0, v12
+ *          14.s32 Add v8, v11
+ *          15.s32 Add v7, v2
+ *          16.s32 Add v14, v13
+ *          17. Br BB.1
+ *       BB.3:
+ *          18.s32 Return v16
+ *
+ *   After strength reduction:
+ *       v11 and v13 are replaced by new phis of BB.1 which are incremented by 4 in BB.2, their initial values
+ *       `v1 * 4` and `v0 + (v1 << 2)` are computed in BB.0, v12 is removed together with v13
+ */
+TEST(STRENGTH_REDUCTION_OPT, MulAndShl)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateConstInt(10);
+    auto *v4 = irBuilder.CreateConstInt(4);
+    auto *v5 = irBuilder.CreateConstInt(2);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v7 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v8 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v7, v3), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v11 = irBuilder.CreateMul(v7, v4);
+    auto *v12 = irBuilder.CreateShl(v7, v5);
+    auto *v13 = irBuilder.CreateAdd(v0, v12);
+    auto *v14 = irBuilder.CreateAdd(v8, v11);
+    auto *v15 = irBuilder.CreateAdd(v7, v2);
+    auto *v16 = irBuilder.CreateAdd(v14, v13);
+    irBuilder.CreateBr(bb1);
+    v7->ResolveDependency(v1, bb0);
+    v7->ResolveDependency(v15, bb2);
+    v8->ResolveDependency(v1, bb0);
+    v8->ResolveDependency(v14, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    irBuilder.CreateRet(v16);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    StrengthReductionOptimizer strengthReduction(&graph);
+    ASSERT(strengthReduction.Run());
+    ASSERT(!strengthReduction.Run());
+    ASSERT(statistics.GetTotalCounter(StatCounter::REDUCED_INDUCTIONS) == 2);
+
+    // the stride of v11 is added on every iteration
+    auto *mulPhi = v14->GetLastOp()->As<ir::PhiInst>();
+    ASSERT(mulPhi->GetOpcode() == ir::Opcode::PHI && mulPhi->GetBasicBlock() == bb1);
+    ASSERT(mulPhi->GetIncomingBlock(0) == bb0 && mulPhi->GetIncomingBlock(1) == bb2);
+    auto *mulStart = mulPhi->GetInput(0);
+    ASSERT(mulStart->GetOpcode() == ir::Opcode::MUL && mulStart->GetBasicBlock() == bb0);
+    ASSERT(mulStart->GetFirstOp() == v1 && mulStart->GetLastOp() == v4);
+    auto *mulNext = mulPhi->GetInput(1);
+    ASSERT(mulNext->GetOpcode() == ir::Opcode::ADD && mulNext->GetBasicBlock() == bb2);
+    ASSERT(mulNext->GetFirstOp() == mulPhi && mulNext->GetLastOp() == v4);
+
+    // `v0 + (v7 << 2)` starts from `v0 + (v1 << 2)`
+    auto *shlPhi = v16->GetLastOp()->As<ir::PhiInst>();
+    ASSERT(shlPhi->GetOpcode() == ir::Opcode::PHI && shlPhi->GetBasicBlock() == bb1 && shlPhi != mulPhi);
+    auto *shlStart = shlPhi->GetInput(0);
+    ASSERT(shlStart->GetOpcode() == ir::Opcode::ADD && shlStart->GetFirstOp() == v0);
+    ASSERT(shlStart->GetLastOp()->GetOpcode() == ir::Opcode::SHL && shlStart->GetLastOp()->GetFirstOp() == v1);
+    ASSERT(shlPhi->GetInput(1)->GetFirstOp() == shlPhi && shlPhi->GetInput(1)->GetLastOp() == v4);
+
+    // the reduced computations are removed
+    bb2->IterateOverInstructions([](ir::Instruction *inst) {
+        ASSERT(inst->GetOpcode() != ir::Opcode::MUL && inst->GetOpcode() != ir::Opcode::SHL);
+        return false;
+    });
+}
+
+/**
+ *   IR Graph:
+ *       BB.0:
+ *           0.s32 Parameter 0
+ *           1.s32 Constant 0
+ *           2.s32 Constant 1
+ *           3.s32 Constant 2
+ *           4. Br BB.1
+ *       BB.1:
+ *           5p.s32 Phi v1:BB.0, v10:BB.2
+ *           6p.s32 Phi v1:BB.0, v11:BB.2
+ *           7p.s32 Phi v1:BB.0, v12:BB.2
+ *           8.b CmpLT v5, v0
+ *           9. CondBr v8, BB.2, BB.3
+ *       BB.2:
+ *          10.s32 Add v5, v2
+ *          11.s32 Add v6, v2
+ *          12.s32 Add v7, v3
+ *          13. Br BB.1
+ *       BB.3:
+ *          14.s32 Add v6, v7
+ *          15.s32 Return v14
+ *
+ *   After strength reduction:
+ *       v6 repeats v5 and is replaced by it, v11 becomes dead and is removed, v7 has another step
+ */
+TEST(STRENGTH_REDUCTION_OPT, RedundantVariables)
+{
+    auto graph = ir::Graph {};
+    auto irBuilder = ir::IRBuilder {&graph};
+
+    auto *bb0 = ir::BasicBlock::Create(&graph);
+    auto *bb1 = ir::BasicBlock::Create(&graph);
+    auto *bb2 = ir::BasicBlock::Create(&graph);
+    auto *bb3 = ir::BasicBlock::Create(&graph);
+
+    irBuilder.SetInsertionPoint(bb0);
+    auto *v0 = irBuilder.CreateParam(ir::ResultType::S32, 0);
+    auto *v1 = irBuilder.CreateConstInt(0);
+    auto *v2 = irBuilder.CreateConstInt(1);
+    auto *v3 = irBuilder.CreateConstInt(2);
+    irBuilder.CreateBr(bb1);
+
+    irBuilder.SetInsertionPoint(bb1);
+    auto *v5 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v6 = irBuilder.CreatePhi(ir::ResultType::S32);
+    auto *v7 = irBuilder.CreatePhi(ir::ResultType::S32);
+    irBuilder.CreateCondBr(irBuilder.CreateCmpLT(v5, v0), bb2, bb3);
+
+    irBuilder.SetInsertionPoint(bb2);
+    auto *v10 = irBuilder.CreateAdd(v5, v2);
+    auto *v11 = irBuilder.CreateAdd(v6, v2);
+    auto *v12 = irBuilder.CreateAdd(v7, v3);
+    irBuilder.CreateBr(bb1);
+    v5->ResolveDependency(v1, bb0);
+    v5->ResolveDependency(v10, bb2);
+    v6->ResolveDependency(v1, bb0);
+    v6->ResolveDependency(v11, bb2);
+    v7->ResolveDependency(v1, bb0);
+    v7->ResolveDependency(v12, bb2);
+
+    irBuilder.SetInsertionPoint(bb3);
+    auto *v14 = irBuilder.CreateAdd(v6, v7);
+    irBuilder.CreateRet(v14);
+
+    auto statistics = CompilerStatistics {};
+    graph.SetStatistics(&statistics);
+    StrengthReductionOptimizer strengthReduction(&graph);
+    ASSERT(strengthReduction.Run());
+    ASSERT(!strengthReduction.Run());
+    ASSERT(statistics.GetTotalCounter(StatCounter::REDUNDANT_INSTS) == 2);
+    ASSERT(statistics.GetTotalCounter(StatCounter::REDUCED_INDUCTIONS) == 0);
+
+    ASSERT(v14->GetFirstOp() == v5 && v14->GetLastOp() == v7);
+    ASSERT(v5->GetInput(1) == v10 && v7->GetInput(1) == v12);
+    size_t bb1Count = 0;
+    bb1->IterateOverInstructions([&bb1Count]([[maybe_unused]] ir::Instruction *inst) {
+        ++bb1Count;
+        return false;
+    });
+    size_t bb2Count = 0;
+    bb2->IterateOverInstructions([&bb2Count]([[maybe_unused]] ir::Instruction *inst) {
+        ++bb2Count;
+        return false;
+    });
+    ASSERT(bb1Count == 4U && bb2Count == 3U);
+}
+
+}  // namespace compiler::tests
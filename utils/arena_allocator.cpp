@@ -0,0 +1,19 @@
+#include "utils/arena_allocator.h"
+
+#include <algorithm>
+
+namespace compiler::utils {
+
+uintptr_t ArenaAllocator::AllocChunk(size_t size, size_t align)
+{
+    // oversized requests get a dedicated chunk
+    auto chunkSize = std::max(chunkSize_, size + align);
+    chunks_.emplace_back(new uint8_t[chunkSize]);
+    reservedBytes_ += chunkSize;
+
+    auto begin = reinterpret_cast<uintptr_t>(chunks_.back().get());
+    end_ = begin + chunkSize;
+    return (begin + align - 1) & ~(align - 1);
+}
+
+}  // namespace compiler::utils
@@ -0,0 +1,81 @@
+#ifndef UTILS_ARENA_ALLOCATOR_H
+#define UTILS_ARENA_ALLOCATOR_H
+
+#include "utils/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace compiler::utils {
+
+// Bump-pointer allocator: objects are carved out of big chunks and the memory
+// is given back only when the arena itself is destroyed
+class ArenaAllocator {
+public:
+    static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+    explicit ArenaAllocator(size_t chunkSize = DefaultChunkSize) : chunkSize_(chunkSize) {}
+    NO_COPY_SEMANTIC(ArenaAllocator);
+    NO_MOVE_OPERATOR(ArenaAllocator);
+
+    // Moved-from arena owns no chunks, so its next allocation starts a new chunk
+    ArenaAllocator(ArenaAllocator &&other) noexcept
+        : chunkSize_(other.chunkSize_),
+          chunks_(std::move(other.chunks_)),
+          current_(std::exchange(other.current_, 0)),
+          end_(std::exchange(other.end_, 0)),
+          allocatedBytes_(std::exchange(other.allocatedBytes_, 0)),
+          reservedBytes_(std::exchange(other.reservedBytes_, 0))
+    {
+        other.chunks_.clear();
+    }
+
+    ~ArenaAllocator() = default;
+
+    void *Alloc(size_t size, size_t align = alignof(std::max_align_t))
+    {
+        ASSERT(align != 0 && (align & (align - 1)) == 0);
+        auto start = (current_ + align - 1) & ~(align - 1);
+        if (UNLIKELY(start + size > end_)) {
+            start = AllocChunk(size, align);
+        }
+        current_ = start + size;
+        allocatedBytes_ += size;
+        return reinterpret_cast<void *>(start);
+    }
+
+    // Destructor of the created object is not called by the arena
+    template <typename T, typename... Args>
+    T *New(Args &&...args)
+    {
+        return new (Alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    size_t GetAllocatedBytes() const
+    {
+        return allocatedBytes_;
+    }
+
+    size_t GetReservedBytes() const
+    {
+        return reservedBytes_;
+    }
+
+private:
+    /// @return aligned start of the new chunk
+    uintptr_t AllocChunk(size_t size, size_t align);
+
+    size_t chunkSize_;
+    std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+    uintptr_t current_ {0};
+    uintptr_t end_ {0};
+    size_t allocatedBytes_ {0};
+    size_t reservedBytes_ {0};
+};
+
+}  // namespace compiler::utils
+
+#endif  // UTILS_ARENA_ALLOCATOR_H
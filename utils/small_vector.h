@@ -0,0 +1,281 @@
+#ifndef UTILS_SMALL_VECTOR_H
+#define UTILS_SMALL_VECTOR_H
+
+#include "utils/macros.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace compiler::utils {
+
+// Vector which keeps up to N elements inside the object and spills to the heap only when it grows beyond them.
+// Elements are relocated with move constructor + destructor, so T may keep pointers to itself up to date
+template <typename T, size_t N>
+class SmallVector {
+public:
+    using value_type = T;
+    using Iterator = T *;
+    using ConstIterator = const T *;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> elements)
+    {
+        Reserve(elements.size());
+        for (auto &elem : elements) {
+            PushBack(elem);
+        }
+    }
+
+    SmallVector(const SmallVector &that)
+    {
+        Reserve(that.Size());
+        for (auto &elem : that) {
+            PushBack(elem);
+        }
+    }
+
+    SmallVector &operator=(const SmallVector &that)
+    {
+        if (this != &that) {
+            Clear();
+            Reserve(that.Size());
+            for (auto &elem : that) {
+                PushBack(elem);
+            }
+        }
+        return *this;
+    }
+
+    SmallVector(SmallVector &&that)
+    {
+        MoveFrom(std::move(that));
+    }
+
+    SmallVector &operator=(SmallVector &&that)
+    {
+        if (this != &that) {
+            Clear();
+            ReleaseHeap();
+            MoveFrom(std::move(that));
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        Clear();
+        ReleaseHeap();
+    }
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+    size_t Capacity() const
+    {
+        return capacity_;
+    }
+
+    bool IsEmpty() const
+    {
+        return size_ == 0;
+    }
+
+    // Is storage still placed inside the object?
+    bool IsInline() const
+    {
+        return data_ == InlineData();
+    }
+
+    T *Data()
+    {
+        return data_;
+    }
+
+    const T *Data() const
+    {
+        return data_;
+    }
+
+    T &operator[](size_t idx)
+    {
+        ASSERT(idx < size_);
+        return data_[idx];
+    }
+
+    const T &operator[](size_t idx) const
+    {
+        ASSERT(idx < size_);
+        return data_[idx];
+    }
+
+    T &Front()
+    {
+        ASSERT(!IsEmpty());
+        return data_[0];
+    }
+
+    const T &Front() const
+    {
+        ASSERT(!IsEmpty());
+        return data_[0];
+    }
+
+    T &Back()
+    {
+        ASSERT(!IsEmpty());
+        return data_[size_ - 1];
+    }
+
+    const T &Back() const
+    {
+        ASSERT(!IsEmpty());
+        return data_[size_ - 1];
+    }
+
+    void PushBack(const T &elem)
+    {
+        EmplaceBack(elem);
+    }
+
+    void PushBack(T &&elem)
+    {
+        EmplaceBack(std::move(elem));
+    }
+
+    template <typename... Args>
+    T &EmplaceBack(Args &&...args)
+    {
+        if (UNLIKELY(size_ == capacity_)) {
+            Grow(capacity_ * 2);
+        }
+        auto *elem = new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *elem;
+    }
+
+    void PopBack()
+    {
+        ASSERT(!IsEmpty());
+        data_[--size_].~T();
+    }
+
+    // Complexity: O(size)
+    Iterator Erase(Iterator pos)
+    {
+        ASSERT(pos >= begin() && pos < end());
+        std::move(pos + 1, end(), pos);
+        PopBack();
+        return pos;
+    }
+
+    void Reserve(size_t capacity)
+    {
+        if (capacity > capacity_) {
+            Grow(capacity);
+        }
+    }
+
+    void Clear()
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    Iterator begin()
+    {
+        return data_;
+    }
+
+    Iterator end()
+    {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const
+    {
+        return data_;
+    }
+
+    ConstIterator end() const
+    {
+        return data_ + size_;
+    }
+
+    bool operator==(const SmallVector &that) const
+    {
+        return std::equal(begin(), end(), that.begin(), that.end());
+    }
+
+    bool operator!=(const SmallVector &that) const
+    {
+        return !(*this == that);
+    }
+
+private:
+    T *InlineData()
+    {
+        return reinterpret_cast<T *>(inlineStorage_);
+    }
+
+    const T *InlineData() const
+    {
+        return reinterpret_cast<const T *>(inlineStorage_);
+    }
+
+    void Grow(size_t capacity)
+    {
+        ASSERT(capacity > capacity_);
+        auto *newData = static_cast<T *>(::operator new(capacity * sizeof(T), std::align_val_t {alignof(T)}));
+        for (size_t idx = 0; idx < size_; ++idx) {
+            new (newData + idx) T(std::move(data_[idx]));
+            data_[idx].~T();
+        }
+        ReleaseHeap();
+        data_ = newData;
+        capacity_ = capacity;
+    }
+
+    void ReleaseHeap()
+    {
+        if (!IsInline()) {
+            ::operator delete(data_, std::align_val_t {alignof(T)});
+            data_ = InlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Pre-condition: this vector is empty and inline
+    void MoveFrom(SmallVector &&that)
+    {
+        ASSERT(IsEmpty() && IsInline());
+        if (!that.IsInline()) {
+            data_ = std::exchange(that.data_, that.InlineData());
+            capacity_ = std::exchange(that.capacity_, N);
+            size_ = std::exchange(that.size_, 0);
+            return;
+        }
+        for (auto &elem : that) {
+            PushBack(std::move(elem));
+        }
+        that.Clear();
+    }
+
+    static_assert(N > 0);
+
+    alignas(T) uint8_t inlineStorage_[N * sizeof(T)];
+    T *data_ {InlineData()};
+    uint32_t size_ {0};
+    uint32_t capacity_ {N};
+};
+
+}  // namespace compiler::utils
+
+#endif  // UTILS_SMALL_VECTOR_H